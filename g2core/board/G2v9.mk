@@ -40,7 +40,7 @@ ifeq ("$(BASE_BOARD)","g2v9")
 	CHIP_LOWERCASE = sam3x8c
 
 	BOARD_PATH = ./board/G2v9
-	SOURCE_DIRS += ${BOARD_PATH} device/step_dir_driver device/esc_spindle device/sd_card
+	SOURCE_DIRS += ${BOARD_PATH} device/step_dir_driver device/esc_spindle device/laser_toolhead device/sd_card
 
 	PLATFORM_BASE = ${MOTATE_PATH}/platform/atmel_sam
 
@@ -86,11 +86,58 @@ const configSubtable * const getSysConfig_3() { return &sys_config_3; }
 
 #endif
 
+// Define LASER_TOOL (in settings or the board) to build the laser toolhead. The laser and the
+// ESC spindle can't share outputs, so either:
+//  - leave LASER_PWM_NUMBER undefined and the laser replaces the ESC spindle on its outputs, or
+//  - define LASER_PWM_NUMBER (and LASER_ENABLE_OUTPUT_NUMBER, if it has one) to outputs of its own,
+//    and M6 to LASER_TOOL selects the laser, any other tool the ESC spindle
+#ifdef LASER_TOOL
+#ifdef LASER_PWM_NUMBER
+#define HAS_ESC_SPINDLE 1
+#if (LASER_PWM_NUMBER == SPINDLE_PWM_NUMBER) || (LASER_PWM_NUMBER == SPINDLE_ENABLE_OUTPUT_NUMBER) || (LASER_PWM_NUMBER == SPINDLE_DIRECTION_OUTPUT_NUMBER)
+#error LASER_PWM_NUMBER is one of the ESC spindle outputs - leave it undefined to replace the spindle with the laser
+#endif
+#ifndef LASER_ENABLE_OUTPUT_NUMBER
+#define LASER_ENABLE_OUTPUT_NUMBER 0    // no enable output
+#endif
+#if (LASER_ENABLE_OUTPUT_NUMBER != 0) && ((LASER_ENABLE_OUTPUT_NUMBER == SPINDLE_PWM_NUMBER) || (LASER_ENABLE_OUTPUT_NUMBER == SPINDLE_ENABLE_OUTPUT_NUMBER) || (LASER_ENABLE_OUTPUT_NUMBER == SPINDLE_DIRECTION_OUTPUT_NUMBER))
+#error LASER_ENABLE_OUTPUT_NUMBER is one of the ESC spindle outputs
+#endif
+#else
+#define HAS_ESC_SPINDLE 0
+#define LASER_PWM_NUMBER SPINDLE_PWM_NUMBER
+#ifndef LASER_ENABLE_OUTPUT_NUMBER
+#define LASER_ENABLE_OUTPUT_NUMBER SPINDLE_ENABLE_OUTPUT_NUMBER
+#endif
+#endif // LASER_PWM_NUMBER
+
+#ifndef LASER_SPEED_MAX
+#define LASER_SPEED_MAX 1000    // S for full power
+#endif
+
+#include "laser_toolhead.h"
+LaserToolHead laser_toolhead {LASER_PWM_NUMBER, LASER_ENABLE_OUTPUT_NUMBER, LASER_SPEED_MAX};
+
+#else
+#define HAS_ESC_SPINDLE 1
+#endif // LASER_TOOL
+
+#if HAS_ESC_SPINDLE
 #include "esc_spindle.h"
 ESCSpindle esc_spindle {SPINDLE_PWM_NUMBER, SPINDLE_ENABLE_OUTPUT_NUMBER, SPINDLE_DIRECTION_OUTPUT_NUMBER, SPINDLE_SPEED_CHANGE_PER_MS};
+#endif
 
 ToolHead *toolhead_for_tool(uint8_t tool) {
+#if !HAS_ESC_SPINDLE
+    return &laser_toolhead;
+#else
+#ifdef LASER_TOOL
+    if (tool == LASER_TOOL) {
+        return &laser_toolhead;
+    }
+#endif
     return &esc_spindle;
+#endif
 }
 
 /*
@@ -103,7 +150,12 @@ void hardware_init()
     sd_card.init();
     setup_sd_persistence();
     board_hardware_init();
-    toolhead_for_tool(0)->init();
+#if HAS_ESC_SPINDLE
+    esc_spindle.init();
+#endif
+#ifdef LASER_TOOL
+    laser_toolhead.init();
+#endif
     spindle_set_toolhead(toolhead_for_tool(0));
 	return;
 }
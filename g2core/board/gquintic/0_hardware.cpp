@@ -43,11 +43,14 @@ Motate::OutputPin<Motate::kExternalClock1_PinNumber> external_clk_pin {Motate::k
 
 HOT_DATA SPI_CS_PinMux_used_t spiCSPinMux;
 HOT_DATA SPIBus_used_t spiBus;
+HOT_DATA SPIScheduler_used_t spiScheduler{spiBus};
 
-// HOT_DATA TWIBus_used_t twiBus;
+#if HAS_EXTERNAL_ENCODERS
+HOT_DATA TWIBus_used_t twiBus;
 
-// // Define Multiplexers
-// HOT_DATA plex0_t plex0{twiBus, 0x0070L};
+// Define Multiplexers
+HOT_DATA plex0_t plex0{twiBus, 0x0070L};
+#endif
 // HOT_DATA plex1_t plex1{twiBus, 0x0071L};
 
 
@@ -62,7 +65,9 @@ HOT_DATA SPIBus_used_t spiBus;
 void hardware_init()
 {
     spiBus.init();
-    // twiBus.init();
+#if HAS_EXTERNAL_ENCODERS
+    twiBus.init();
+#endif
     board_hardware_init();
     external_clk_pin = 0; // Force external clock to 0 for now.
 }
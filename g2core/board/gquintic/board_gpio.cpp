@@ -91,8 +91,8 @@ gpioDigitalOutput* const d_out[] = {&dout1, &dout2, &dout3, &dout4, &dout5, &dou
 
 #if QUINTIC_REVISION == 'C'
 
-gpioAnalogInputPin<MAX31865<SPIBus_used_t::SPIBusDevice>> ai1 {AI1_ENABLED, gpioAnalogInput::AIN_TYPE_EXTERNAL, 1, AI1_EXTERNAL_NUMBER, spiBus, spiCSPinMux.getCS(5)};
-gpioAnalogInputPin<MAX31865<SPIBus_used_t::SPIBusDevice>> ai2 {AI2_ENABLED, gpioAnalogInput::AIN_TYPE_EXTERNAL, 2, AI2_EXTERNAL_NUMBER, spiBus, spiCSPinMux.getCS(6)};
+gpioAnalogInputPin<MAX31865<SPIScheduler_used_t::Device_t>> ai1 {AI1_ENABLED, gpioAnalogInput::AIN_TYPE_EXTERNAL, 1, AI1_EXTERNAL_NUMBER, spiScheduler.bus(kSPIPriorityThermal), spiCSPinMux.getCS(5)};
+gpioAnalogInputPin<MAX31865<SPIScheduler_used_t::Device_t>> ai2 {AI2_ENABLED, gpioAnalogInput::AIN_TYPE_EXTERNAL, 2, AI2_EXTERNAL_NUMBER, spiScheduler.bus(kSPIPriorityThermal), spiCSPinMux.getCS(6)};
 gpioAnalogInputPin<ADCDifferentialPair<Motate::kADC1_Neg_PinNumber, Motate::kADC1_Pos_PinNumber>> ai3 {AI3_ENABLED, gpioAnalogInput::AIN_TYPE_INTERNAL, 3, AI3_EXTERNAL_NUMBER};
 gpioAnalogInputPin<ADCDifferentialPair<Motate::kADC2_Neg_PinNumber, Motate::kADC2_Pos_PinNumber>> ai4 {AI4_ENABLED, gpioAnalogInput::AIN_TYPE_INTERNAL, 4, AI4_EXTERNAL_NUMBER};
 
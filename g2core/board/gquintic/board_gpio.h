@@ -105,7 +105,7 @@ extern gpioDigitalOutput*  const d_out[D_OUT_CHANNELS];
 #ifndef AI1_CIRCUIT
 #define AI1_CIRCUIT gpioAnalogInput::AIN_CIRCUIT_EXTERNAL
 #endif
-extern gpioAnalogInputPin<MAX31865<SPIBus_used_t::SPIBusDevice>> ain1;
+extern gpioAnalogInputPin<MAX31865<SPIScheduler_used_t::Device_t>> ain1;
 
 #ifndef AI2_ENABLED
 #define AI2_ENABLED IO_ENABLED
@@ -116,7 +116,7 @@ extern gpioAnalogInputPin<MAX31865<SPIBus_used_t::SPIBusDevice>> ain1;
 #ifndef AI2_CIRCUIT
 #define AI2_CIRCUIT gpioAnalogInput::AIN_CIRCUIT_EXTERNAL
 #endif
-extern gpioAnalogInputPin<MAX31865<SPIBus_used_t::SPIBusDevice>> ain2;
+extern gpioAnalogInputPin<MAX31865<SPIScheduler_used_t::Device_t>> ain2;
 
 #ifndef AI3_ENABLED
 #define AI3_ENABLED IO_ENABLED
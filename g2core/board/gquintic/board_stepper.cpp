@@ -28,31 +28,32 @@
  */
 
 #include "board_stepper.h"
+#include "encoder.h"
 
 #include "MotateTimers.h"
 
 // These are identical to board_stepper.h, except for the word "extern" and the initialization
 #if QUINTIC_REVISION == 'C'
-HOT_DATA Trinamic2130<SPIBus_used_t::SPIBusDevice,
+HOT_DATA Trinamic2130<SPIScheduler_used_t::Device_t,
              Motate::kSocket2_StepPinNumber,
              Motate::kSocket2_DirPinNumber,
              Motate::kSocket2_EnablePinNumber>
-    motor_1 {spiBus, spiCSPinMux.getCS(3)};
-HOT_DATA Trinamic2130<SPIBus_used_t::SPIBusDevice,
+    motor_1 {spiScheduler.bus(kSPIPriorityMotion), spiCSPinMux.getCS(3)};
+HOT_DATA Trinamic2130<SPIScheduler_used_t::Device_t,
              Motate::kSocket3_StepPinNumber,
              Motate::kSocket3_DirPinNumber,
              Motate::kSocket3_EnablePinNumber>
-    motor_2 {spiBus, spiCSPinMux.getCS(2)};
-HOT_DATA Trinamic2130<SPIBus_used_t::SPIBusDevice,
+    motor_2 {spiScheduler.bus(kSPIPriorityMotion), spiCSPinMux.getCS(2)};
+HOT_DATA Trinamic2130<SPIScheduler_used_t::Device_t,
              Motate::kSocket4_StepPinNumber,
              Motate::kSocket4_DirPinNumber,
              Motate::kSocket4_EnablePinNumber>
-    motor_3 {spiBus, spiCSPinMux.getCS(1)};
-HOT_DATA Trinamic2130<SPIBus_used_t::SPIBusDevice,
+    motor_3 {spiScheduler.bus(kSPIPriorityMotion), spiCSPinMux.getCS(1)};
+HOT_DATA Trinamic2130<SPIScheduler_used_t::Device_t,
              Motate::kSocket5_StepPinNumber,
              Motate::kSocket5_DirPinNumber,
              Motate::kSocket5_EnablePinNumber>
-    motor_4 {spiBus, spiCSPinMux.getCS(0)};
+    motor_4 {spiScheduler.bus(kSPIPriorityMotion), spiCSPinMux.getCS(0)};
 #if HAS_HOBBY_SERVO_MOTOR
 HOT_DATA StepDirHobbyServo<Motate::kServo1_PinNumber> motor_5;
 Stepper* const Motors[MOTORS] = {&motor_1, &motor_2, &motor_3, &motor_4, &motor_5};
@@ -62,31 +63,31 @@ Stepper* const Motors[MOTORS] = {&motor_1, &motor_2, &motor_3, &motor_4};
 #endif // 'C'
 
 #if QUINTIC_REVISION == 'D'
-HOT_DATA Trinamic2130<SPIBus_used_t::SPIBusDevice,
+HOT_DATA Trinamic2130<SPIScheduler_used_t::Device_t,
              Motate::kSocket1_StepPinNumber,
              Motate::kSocket1_DirPinNumber,
              Motate::kSocket1_EnablePinNumber>
-    motor_1 {spiBus, spiCSPinMux.getCS(4)};
-HOT_DATA Trinamic2130<SPIBus_used_t::SPIBusDevice,
+    motor_1 {spiScheduler.bus(kSPIPriorityMotion), spiCSPinMux.getCS(4)};
+HOT_DATA Trinamic2130<SPIScheduler_used_t::Device_t,
              Motate::kSocket2_StepPinNumber,
              Motate::kSocket2_DirPinNumber,
              Motate::kSocket2_EnablePinNumber>
-    motor_2 {spiBus, spiCSPinMux.getCS(3)};
-HOT_DATA Trinamic2130<SPIBus_used_t::SPIBusDevice,
+    motor_2 {spiScheduler.bus(kSPIPriorityMotion), spiCSPinMux.getCS(3)};
+HOT_DATA Trinamic2130<SPIScheduler_used_t::Device_t,
              Motate::kSocket3_StepPinNumber,
              Motate::kSocket3_DirPinNumber,
              Motate::kSocket3_EnablePinNumber>
-    motor_3 {spiBus, spiCSPinMux.getCS(2)};
-HOT_DATA Trinamic2130<SPIBus_used_t::SPIBusDevice,
+    motor_3 {spiScheduler.bus(kSPIPriorityMotion), spiCSPinMux.getCS(2)};
+HOT_DATA Trinamic2130<SPIScheduler_used_t::Device_t,
              Motate::kSocket4_StepPinNumber,
              Motate::kSocket4_DirPinNumber,
              Motate::kSocket4_EnablePinNumber>
-    motor_4 {spiBus, spiCSPinMux.getCS(1)};
-HOT_DATA Trinamic2130<SPIBus_used_t::SPIBusDevice,
+    motor_4 {spiScheduler.bus(kSPIPriorityMotion), spiCSPinMux.getCS(1)};
+HOT_DATA Trinamic2130<SPIScheduler_used_t::Device_t,
              Motate::kSocket5_StepPinNumber,
              Motate::kSocket5_DirPinNumber,
              Motate::kSocket5_EnablePinNumber>
-    motor_5 {spiBus, spiCSPinMux.getCS(0)};
+    motor_5 {spiScheduler.bus(kSPIPriorityMotion), spiCSPinMux.getCS(0)};
 #if HAS_HOBBY_SERVO_MOTOR
 HOT_DATA StepDirHobbyServo<Motate::kServo1_PinNumber> motor_6;
 Stepper* const Motors[MOTORS] = {&motor_1, &motor_2, &motor_3, &motor_4, &motor_5, &motor_6};
@@ -95,7 +96,7 @@ Stepper* const Motors[MOTORS] = {&motor_1, &motor_2, &motor_3, &motor_4, &motor_
 #endif
 #endif // 'D'
 
-#if (KINEMATICS == KINE_FOUR_CABLE)
+#if HAS_EXTERNAL_ENCODERS
 HOT_DATA encoder_0_t encoder_0{plex0, M1_ENCODER_INPUT_A, M1_ENCODER_INPUT_B, 1 << 0};
 HOT_DATA encoder_1_t encoder_1{plex0, M2_ENCODER_INPUT_A, M2_ENCODER_INPUT_B, 1 << 1};
 HOT_DATA encoder_2_t encoder_2{plex0, M3_ENCODER_INPUT_A, M3_ENCODER_INPUT_B, 1 << 2};
@@ -103,17 +104,7 @@ HOT_DATA encoder_3_t encoder_3{plex0, M4_ENCODER_INPUT_A, M4_ENCODER_INPUT_B, 1
 
 ExternalEncoder* const ExternalEncoders[4] = {&encoder_0, &encoder_1, &encoder_2, &encoder_3};
 
-int8_t ee_sample_counter_ = 100;
-Motate::SysTickEvent external_encoders_tick_event {[&] {
-    if (!--ee_sample_counter_) {
-
-        encoder_0.requestAngleFraction();
-        encoder_1.requestAngleFraction();
-        encoder_2.requestAngleFraction();
-        encoder_3.requestAngleFraction();
-        ee_sample_counter_ = 1;
-    }
-}, nullptr};
+HOT_DATA encoder_poller_t encoder_poller{EXTERNAL_ENCODER_SAMPLE_MS, &encoder_0, &encoder_1, &encoder_2, &encoder_3};
 
 #else
 ExternalEncoder* const ExternalEncoders[0] = {};
@@ -121,5 +112,12 @@ ExternalEncoder* const ExternalEncoders[0] = {};
 
 void board_stepper_init() {
     for (uint8_t motor = 0; motor < MOTORS; motor++) { Motors[motor]->init(); }
-    // Motate::SysTickTimer.registerEvent(&external_encoders_tick_event);
+#if HAS_EXTERNAL_ENCODERS
+#if (KINEMATICS != KINE_FOUR_CABLE)         // four cable kinematics reads the encoders itself
+    for (uint8_t motor = 0; motor < 4; motor++) {
+        en_attach_external_encoder(motor, ExternalEncoders[motor], EXTERNAL_ENCODER_REVS_PER_MOTOR_REV);
+    }
+#endif
+    encoder_poller.start();
+#endif
 }
@@ -35,22 +35,22 @@
 
 // These are identical to board_stepper.h, except for the word "extern" and the initialization
 #if QUINTIC_REVISION == 'C'
-extern Trinamic2130<SPIBus_used_t::SPIBusDevice,
+extern Trinamic2130<SPIScheduler_used_t::Device_t,
                     Motate::kSocket2_StepPinNumber,
                     Motate::kSocket2_DirPinNumber,
                     Motate::kSocket2_EnablePinNumber>
     motor_1;
-extern Trinamic2130<SPIBus_used_t::SPIBusDevice,
+extern Trinamic2130<SPIScheduler_used_t::Device_t,
                     Motate::kSocket3_StepPinNumber,
                     Motate::kSocket3_DirPinNumber,
                     Motate::kSocket3_EnablePinNumber>
     motor_2;
-extern Trinamic2130<SPIBus_used_t::SPIBusDevice,
+extern Trinamic2130<SPIScheduler_used_t::Device_t,
                     Motate::kSocket4_StepPinNumber,
                     Motate::kSocket4_DirPinNumber,
                     Motate::kSocket4_EnablePinNumber>
     motor_3;
-extern Trinamic2130<SPIBus_used_t::SPIBusDevice,
+extern Trinamic2130<SPIScheduler_used_t::Device_t,
                     Motate::kSocket5_StepPinNumber,
                     Motate::kSocket5_DirPinNumber,
                     Motate::kSocket5_EnablePinNumber>
@@ -61,31 +61,31 @@ extern StepDirHobbyServo<Motate::kServo1_PinNumber> motor_5;
 #endif // 'C'
 
 #if QUINTIC_REVISION == 'D'
-extern Trinamic2130<SPIBus_used_t::SPIBusDevice,
+extern Trinamic2130<SPIScheduler_used_t::Device_t,
                     Motate::kSocket1_StepPinNumber,
                     Motate::kSocket1_DirPinNumber,
                     Motate::kSocket1_EnablePinNumber>
     motor_1;
 
-extern Trinamic2130<SPIBus_used_t::SPIBusDevice,
+extern Trinamic2130<SPIScheduler_used_t::Device_t,
                     Motate::kSocket2_StepPinNumber,
                     Motate::kSocket2_DirPinNumber,
                     Motate::kSocket2_EnablePinNumber>
     motor_2;
 
-extern Trinamic2130<SPIBus_used_t::SPIBusDevice,
+extern Trinamic2130<SPIScheduler_used_t::Device_t,
                     Motate::kSocket3_StepPinNumber,
                     Motate::kSocket3_DirPinNumber,
                     Motate::kSocket3_EnablePinNumber>
     motor_3;
 
-extern Trinamic2130<SPIBus_used_t::SPIBusDevice,
+extern Trinamic2130<SPIScheduler_used_t::Device_t,
                     Motate::kSocket4_StepPinNumber,
                     Motate::kSocket4_DirPinNumber,
                     Motate::kSocket4_EnablePinNumber>
     motor_4;
 
-extern Trinamic2130<SPIBus_used_t::SPIBusDevice,
+extern Trinamic2130<SPIScheduler_used_t::Device_t,
                     Motate::kSocket5_StepPinNumber,
                     Motate::kSocket5_DirPinNumber,
                     Motate::kSocket5_EnablePinNumber>
@@ -97,7 +97,24 @@ extern StepDirHobbyServo<Motate::kServo1_PinNumber> motor_6;
 
 extern Stepper* const Motors[MOTORS];
 
-#if (KINEMATICS == KINE_FOUR_CABLE)
+#if HAS_EXTERNAL_ENCODERS
+#ifndef M1_ENCODER_INPUT_A                  // quadrature inputs (not used while polled)
+#define M1_ENCODER_INPUT_A 0
+#define M1_ENCODER_INPUT_B 0
+#endif
+#ifndef M2_ENCODER_INPUT_A
+#define M2_ENCODER_INPUT_A 0
+#define M2_ENCODER_INPUT_B 0
+#endif
+#ifndef M3_ENCODER_INPUT_A
+#define M3_ENCODER_INPUT_A 0
+#define M3_ENCODER_INPUT_B 0
+#endif
+#ifndef M4_ENCODER_INPUT_A
+#define M4_ENCODER_INPUT_A 0
+#define M4_ENCODER_INPUT_B 0
+#endif
+
 using encoder_0_t = decltype(I2C_AS5601{plex0, M1_ENCODER_INPUT_A, M1_ENCODER_INPUT_B, 1 << 0});
 extern HOT_DATA encoder_0_t encoder_0;
 using encoder_1_t = decltype(I2C_AS5601{plex0, M2_ENCODER_INPUT_A, M2_ENCODER_INPUT_B, 1 << 1});
@@ -108,6 +125,20 @@ using encoder_3_t = decltype(I2C_AS5601{plex0, M4_ENCODER_INPUT_A, M4_ENCODER_IN
 extern HOT_DATA encoder_3_t encoder_3;
 
 extern ExternalEncoder* const ExternalEncoders[4];
+
+// All four encoders are read together every EXTERNAL_ENCODER_SAMPLE_MS
+#ifndef EXTERNAL_ENCODER_SAMPLE_MS
+#define EXTERNAL_ENCODER_SAMPLE_MS 2
+#endif
+using encoder_poller_t = I2C_AS5601_Poller<encoder_0_t, 4>;
+extern HOT_DATA encoder_poller_t encoder_poller;
+
+// Encoder turns per motor turn, used for following error correction. Negative if the
+// encoders count the other way to the motors.
+#ifndef EXTERNAL_ENCODER_REVS_PER_MOTOR_REV
+#define EXTERNAL_ENCODER_REVS_PER_MOTOR_REV 1.0
+#endif
+
 #else
 extern ExternalEncoder* const ExternalEncoders[0];
 #endif
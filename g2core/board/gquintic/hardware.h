@@ -49,6 +49,12 @@
 #define HAS_HOBBY_SERVO_MOTOR 0
 #endif
 
+// AS5601 encoders on motors 1-4, read over TWI through multiplexer 0. Four cable kinematics
+// uses them for the cable lengths, otherwise they correct the motors' following error.
+#ifndef HAS_EXTERNAL_ENCODERS
+#define HAS_EXTERNAL_ENCODERS (KINEMATICS == KINE_FOUR_CABLE)
+#endif
+
 #if QUINTIC_REVISION == 'C' or !HAS_HOBBY_SERVO_MOTOR
 #define MOTORS      5               // number of motors on the board - 5Trinamics OR 4 Trinamics + 1 servo
 #else
@@ -81,11 +87,15 @@
 #include "MotateSPI.h"
 #include "MotateTWI.h"
 #include "MotateTimers.h"           // for TimerChanel<> and related...
+#include "spi_scheduler.h"
+
+#if HAS_EXTERNAL_ENCODERS
+#include "i2c_multiplexer.h"
+#include "i2c_as5601.h" // For AS5601
+#endif
 
 // Temporarily disabled:
 // #include "i2c_eeprom.h"
-// #include "i2c_multiplexer.h"
-// #include "i2c_as5601.h" // For AS5601
 
 using Motate::TimerChannel;
 
@@ -145,15 +155,21 @@ typedef TimerChannel<11, 0> fwd_plan_timer_type;   // request forward planner in
 typedef Motate::SPIBus<Motate::kSPI_MISOPinNumber, Motate::kSPI_MOSIPinNumber, Motate::kSPI_SCKPinNumber> SPIBus_used_t;
 extern SPIBus_used_t spiBus;
 
+// The drivers and the MAX31865s share the bus - make their devices on spiScheduler.bus(priority)
+typedef SPIScheduler<SPIBus_used_t> SPIScheduler_used_t;
+extern SPIScheduler_used_t spiScheduler;
+
 typedef Motate::SPIChipSelectPinMux<Motate::kSocket1_SPISlaveSelectPinNumber, Motate::kSocket2_SPISlaveSelectPinNumber, Motate::kSocket3_SPISlaveSelectPinNumber, Motate::kSocket4_SPISlaveSelectPinNumber> SPI_CS_PinMux_used_t;
 extern SPI_CS_PinMux_used_t spiCSPinMux;
 
 /**** TWI Setup ****/
-// typedef Motate::TWIBus<Motate::kI2C_SCLPinNumber, Motate::kI2C_SDAPinNumber> TWIBus_used_t;
-// extern TWIBus_used_t twiBus;
+#if HAS_EXTERNAL_ENCODERS
+typedef Motate::TWIBus<Motate::kI2C_SCLPinNumber, Motate::kI2C_SDAPinNumber> TWIBus_used_t;
+extern TWIBus_used_t twiBus;
 
-// using plex0_t = decltype(I2C_Multiplexer{twiBus, 0x0070L});
-// extern HOT_DATA plex0_t plex0;
+using plex0_t = decltype(I2C_Multiplexer{twiBus, 0x0070L});
+extern HOT_DATA plex0_t plex0;
+#endif
 // using plex1_t = decltype(I2C_Multiplexer{twiBus, 0x0071L});
 // extern HOT_DATA plex1_t plex1;
 
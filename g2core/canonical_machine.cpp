@@ -1806,6 +1806,7 @@ stat_t cm_run_home(nvObj_t *nv)
  *
  * cm_get_jogging_dest()
  * cm_run_jog()
+ * cm_run_jv()
  */
 
 float cm_get_jogging_dest(void)
@@ -1820,6 +1821,13 @@ stat_t cm_run_jog(nvObj_t *nv)
     return (STAT_OK);
 }
 
+stat_t cm_run_jv(nvObj_t *nv)
+{
+    float velocity;
+    ritorno(set_float(nv, velocity));
+    return (cm_jogging_velocity(_axis(nv), velocity));
+}
+
 /**************************************
  * END OF CANONICAL MACHINE FUNCTIONS *
  **************************************/
@@ -2344,7 +2352,7 @@ stat_t cm_set_jh(nvObj_t *nv)
  */
 
 stat_t cm_get_hi(nvObj_t *nv) { return (get_integer(nv, cm->a[_axis(nv)].homing_input)); }
-stat_t cm_set_hi(nvObj_t *nv) { return (set_integer(nv, cm->a[_axis(nv)].homing_input, 0, D_IN_CHANNELS)); }
+stat_t cm_set_hi(nvObj_t *nv) { return (set_integer(nv, cm->a[_axis(nv)].homing_input, 0, STALL_INPUT(MOTORS-1))); }
 stat_t cm_get_hd(nvObj_t *nv) { return (get_integer(nv, cm->a[_axis(nv)].homing_dir)); }
 stat_t cm_set_hd(nvObj_t *nv) { return (set_integer(nv, cm->a[_axis(nv)].homing_dir, 0, 1)); }
 stat_t cm_get_sv(nvObj_t *nv) { return (get_float(nv, cm->a[_axis(nv)].search_velocity)); }
@@ -2356,6 +2364,67 @@ stat_t cm_set_lb(nvObj_t *nv) { return (set_float(nv, cm->a[_axis(nv)].latch_bac
 stat_t cm_get_zb(nvObj_t *nv) { return (get_float(nv, cm->a[_axis(nv)].zero_backoff)); }
 stat_t cm_set_zb(nvObj_t *nv) { return (set_float(nv, cm->a[_axis(nv)].zero_backoff)); }
 
+/**** Axis Input Shaping Settings
+ * cm_get_is() - get input shaper type
+ * cm_set_is() - set input shaper type
+ * cm_get_if() - get input shaper frequency
+ * cm_set_if() - set input shaper frequency
+ * cm_get_id() - get input shaper damping ratio
+ * cm_set_id() - set input shaper damping ratio
+ *
+ *  Changes take effect once the shaper has settled - see plan_shaper.cpp
+ */
+
+stat_t cm_get_is(nvObj_t *nv) { return (get_integer(nv, cm->a[_axis(nv)].shaper_type)); }
+stat_t cm_set_is(nvObj_t *nv)
+{
+    ritorno(set_integer(nv, cm->a[_axis(nv)].shaper_type, SHAPER_NONE, SHAPER_EI));
+    mp_shaper_config_changed();
+    return (STAT_OK);
+}
+
+stat_t cm_get_if(nvObj_t *nv) { return (get_float(nv, cm->a[_axis(nv)].shaper_frequency)); }
+stat_t cm_set_if(nvObj_t *nv)
+{
+    ritorno(set_float_range(nv, cm->a[_axis(nv)].shaper_frequency, SHAPER_FREQUENCY_MIN, SHAPER_FREQUENCY_MAX));
+    mp_shaper_config_changed();
+    return (STAT_OK);
+}
+
+stat_t cm_get_id(nvObj_t *nv) { return (get_float(nv, cm->a[_axis(nv)].shaper_damping)); }
+stat_t cm_set_id(nvObj_t *nv)
+{
+    ritorno(set_float_range(nv, cm->a[_axis(nv)].shaper_damping, 0, SHAPER_DAMPING_MAX));
+    mp_shaper_config_changed();
+    return (STAT_OK);
+}
+
+/**** Axis Pressure Advance Settings
+ * cm_get_pa() - get pressure advance K (seconds)
+ * cm_set_pa() - set pressure advance K (seconds)
+ * cm_get_ps() - get pressure advance smooth time (seconds)
+ * cm_set_ps() - set pressure advance smooth time (seconds)
+ *
+ *  Only provided for the A, B and C axes, which the printer configs use as extruders.
+ *  Changes take effect once the shaper has settled - see plan_shaper.cpp
+ */
+
+stat_t cm_get_pa(nvObj_t *nv) { return (get_float(nv, cm->a[_axis(nv)].pressure_advance)); }
+stat_t cm_set_pa(nvObj_t *nv)
+{
+    ritorno(set_float_range(nv, cm->a[_axis(nv)].pressure_advance, 0, PRESSURE_ADVANCE_MAX));
+    mp_shaper_config_changed();
+    return (STAT_OK);
+}
+
+stat_t cm_get_ps(nvObj_t *nv) { return (get_float(nv, cm->a[_axis(nv)].pressure_advance_smooth)); }
+stat_t cm_set_ps(nvObj_t *nv)
+{
+    ritorno(set_float_range(nv, cm->a[_axis(nv)].pressure_advance_smooth, PRESSURE_ADVANCE_SMOOTH_MIN, PRESSURE_ADVANCE_SMOOTH_MAX));
+    mp_shaper_config_changed();
+    return (STAT_OK);
+}
+
 /*** Canonical Machine Global Settings ***/
 /*
  * cm_get_jt()  - get junction integration time
@@ -2366,6 +2435,10 @@ stat_t cm_set_zb(nvObj_t *nv) { return (set_float(nv, cm->a[_axis(nv)].zero_back
  * cm_set_sl()  - set soft limit enable
  * cm_get_lim() - get hard limit enable
  * cm_set_lim() - set hard limit enable
+ * cm_get_hsim() - get simultaneous homing enable
+ * cm_set_hsim() - set simultaneous homing enable
+ * cm_get_jvt() - get velocity jog keep-alive time
+ * cm_set_jvt() - set velocity jog keep-alive time
  * cm_get_saf() - get safety interlock enable
  * cm_set_saf() - set safety interlock enable
  * cm_set_mfo() - set manual feedrate override factor
@@ -2394,6 +2467,12 @@ stat_t cm_set_sl(nvObj_t *nv) { return(set_integer(nv, (uint8_t &)cm->soft_limit
 stat_t cm_get_lim(nvObj_t *nv) { return(get_integer(nv, cm->limit_enable)); }
 stat_t cm_set_lim(nvObj_t *nv) { return(set_integer(nv, (uint8_t &)cm->limit_enable, 0, 1)); }
 
+stat_t cm_get_hsim(nvObj_t *nv) { return(get_integer(nv, cm->homing_simultaneous)); }
+stat_t cm_set_hsim(nvObj_t *nv) { return(set_integer(nv, (uint8_t &)cm->homing_simultaneous, 0, 1)); }
+
+stat_t cm_get_jvt(nvObj_t *nv) { return(get_float(nv, cm->jogging_keepalive)); }
+stat_t cm_set_jvt(nvObj_t *nv) { return(set_float_range(nv, cm->jogging_keepalive, 10, 10000)); }
+
 stat_t cm_get_m48(nvObj_t *nv) { return(get_integer(nv, cm->gmx.m48_enable)); }
 stat_t cm_set_m48(nvObj_t *nv) { return(set_integer(nv, (uint8_t &)cm->gmx.m48_enable, 0, 1)); }
 
@@ -2521,6 +2600,8 @@ static const char fmt_ct[] = "[ct]  chordal tolerance%17.4f%s\n";
 static const char fmt_zl[] = "[zl]  Z lift on feedhold%16.3f%s\n";
 static const char fmt_sl[] = "[sl]  soft limit enable%12d [0=disable,1=enable]\n";
 static const char fmt_lim[] ="[lim] limit switch enable%10d [0=disable,1=enable]\n";
+static const char fmt_hsim[]="[hsim] simultaneous homing%9d [0=one axis at a time,1=X and Y together]\n";
+static const char fmt_jvt[] ="[jvt] jog keep-alive time%14.0f ms\n";
 static const char fmt_saf[] ="[saf] safety interlock enable%6d [0=disable,1=enable]\n";
 
 void cm_print_jt(nvObj_t *nv) { text_print(nv, fmt_jt);}        // TYPE FLOAT
@@ -2528,6 +2609,8 @@ void cm_print_ct(nvObj_t *nv) { text_print_flt_units(nv, fmt_ct, GET_UNITS(ACTIV
 void cm_print_zl(nvObj_t *nv) { text_print_flt_units(nv, fmt_zl, GET_UNITS(ACTIVE_MODEL));}
 void cm_print_sl(nvObj_t *nv) { text_print(nv, fmt_sl);}        // TYPE_INT
 void cm_print_lim(nvObj_t *nv){ text_print(nv, fmt_lim);}       // TYPE_INT
+void cm_print_hsim(nvObj_t *nv){ text_print(nv, fmt_hsim);}     // TYPE_INT
+void cm_print_jvt(nvObj_t *nv) { text_print(nv, fmt_jvt);}      // TYPE_FLOAT
 void cm_print_saf(nvObj_t *nv){ text_print(nv, fmt_saf);}       // TYPE_INT
 
 static const char fmt_m48[]  = "[m48] overrides enabled%12d [0=disable,1=enable]\n";
@@ -2566,6 +2649,11 @@ void cm_print_nxln(nvObj_t *nv) { text_print(nv, fmt_nxln);};   // TYPE INT
  *    cm_print_lv()
  *    cm_print_lb()
  *    cm_print_zb()
+ *    cm_print_is()
+ *    cm_print_if()
+ *    cm_print_id()
+ *    cm_print_pa()
+ *    cm_print_ps()
  *
  *    cm_print_pos() - print position with unit displays for MM or Inches
  *    cm_print_mpo() - print position with fixed unit display - always in Degrees or MM
@@ -2586,6 +2674,11 @@ static const char fmt_Xsv[] = "[%s%s] %s search velocity%12.0f%s/min\n";
 static const char fmt_Xlv[] = "[%s%s] %s latch velocity%13.2f%s/min\n";
 static const char fmt_Xlb[] = "[%s%s] %s latch backoff%18.3f%s\n";
 static const char fmt_Xzb[] = "[%s%s] %s zero backoff%19.3f%s\n";
+static const char fmt_Xis[] = "[%s%s] %s input shaper%15d [0=none, 1=ZV, 2=ZVD, 3=EI]\n";
+static const char fmt_Xif[] = "[%s%s] %s shaper frequency%11.1f Hz\n";
+static const char fmt_Xid[] = "[%s%s] %s shaper damping%17.3f\n";
+static const char fmt_Xpa[] = "[%s%s] %s pressure advance%15.3f sec\n";
+static const char fmt_Xps[] = "[%s%s] %s advance smoothing%14.3f sec\n";
 static const char fmt_cofs[] = "[%s%s] %s %s offset%20.3f%s\n";
 static const char fmt_cpos[] = "[%s%s] %s %s position%18.3f%s\n";
 
@@ -2663,6 +2756,11 @@ void cm_print_sv(nvObj_t *nv) { _print_axis_flt(nv, fmt_Xsv);}
 void cm_print_lv(nvObj_t *nv) { _print_axis_flt(nv, fmt_Xlv);}
 void cm_print_lb(nvObj_t *nv) { _print_axis_flt(nv, fmt_Xlb);}
 void cm_print_zb(nvObj_t *nv) { _print_axis_flt(nv, fmt_Xzb);}
+void cm_print_is(nvObj_t *nv) { _print_axis_ui8(nv, fmt_Xis);}
+void cm_print_if(nvObj_t *nv) { _print_axis_flt(nv, fmt_Xif);}
+void cm_print_id(nvObj_t *nv) { _print_axis_flt(nv, fmt_Xid);}
+void cm_print_pa(nvObj_t *nv) { _print_axis_flt(nv, fmt_Xpa);}
+void cm_print_ps(nvObj_t *nv) { _print_axis_flt(nv, fmt_Xps);}
 
 void cm_print_cofs(nvObj_t *nv) { _print_axis_coord_flt(nv, fmt_cofs);}
 void cm_print_cpos(nvObj_t *nv) { _print_axis_coord_flt(nv, fmt_cpos);}
@@ -205,12 +205,19 @@ typedef struct cmAxis {
     float high_junction_accel;
 
     // homing settings
-    uint8_t homing_input;                   // set 1-N for homing input. 0 will disable homing
+    uint8_t homing_input;                   // set 1-N for homing input, or a STALL_INPUT(). 0 will disable homing
     uint8_t homing_dir;                     // 0=search to negative, 1=search to positive
     float search_velocity;                  // homing search velocity
     float latch_velocity;                   // homing latch velocity
     float latch_backoff;                    // backoff sufficient to clear a switch
     float zero_backoff;                     // backoff from switches for machine zero
+
+    // input shaping settings (see plan_shaper.cpp)
+    uint8_t shaper_type;                    // see mpShaperType
+    float shaper_frequency;                 // ringing frequency in Hz
+    float shaper_damping;                   // ringing damping ratio
+    float pressure_advance;                 // extruder pressure advance K in seconds, 0 for none
+    float pressure_advance_smooth;          // pressure advance velocity smoothing time in seconds
 } cfgAxis_t;
 
 typedef struct cmArc {                      // planner and runtime variables for arc generation
@@ -255,6 +262,7 @@ typedef struct cmMachine {                  // struct to manage canonical machin
     float feedhold_z_lift;                  // mm to move Z axis on feedhold, or 0 to disable
     bool soft_limit_enable;                 // true to enable soft limit testing on Gcode inputs
     bool limit_enable;                      // true to enable limit switches (disabled is same as override)
+    bool homing_simultaneous;               // true to home X and Y together (see cycle_homing.cpp)
 
     // Coordinate systems and offsets
     float coord_offset[COORDS+1][AXES];     // persistent coordinate offsets: absolute (G53) + G54,G55,G56,G57,G58,G59
@@ -304,6 +312,7 @@ typedef struct cmMachine {                  // struct to manage canonical machin
     float rotation_z_offset;                // separately handle a z-offset to maintain consistent distance to bed
 
     float jogging_dest;                     // jogging destination as a relative move from current position
+    float jogging_keepalive;                // velocity jog keep-alive time in ms
 
   /**** Model state structures ****/
     void *mp;                               // linked mpPlanner_t - use a void pointer to avoid circular header files
@@ -493,7 +502,11 @@ void cm_abort_homing(cmMachine_t *_cm); // called from the queue flush sequence
 // Probe cycles
 stat_t cm_straight_probe(float target[], bool flags[],          // G38.x
                          bool trip_sense, bool alarm_flag);
-stat_t cm_probing_cycle_callback(void);                         // G38.x main loop callback
+stat_t cm_probe_grid(const float target[], const bool flags[],  // G29.1
+                     const float extent[], const bool extent_flags[],
+                     const float P_word, const bool P_flag,
+                     const uint8_t L_word, const bool L_flag);
+stat_t cm_probing_cycle_callback(void);                         // G38.x and G29.1 main loop callback
 void cm_abort_probing(cmMachine_t *_cm); // called from the queue flush sequence to clean up
 
 stat_t cm_get_prbr(nvObj_t *nv);                                // enable/disable probe report
@@ -502,6 +515,7 @@ stat_t cm_set_prbr(nvObj_t *nv);
 // Jogging cycle (cycle_jogging.cpp)
 stat_t cm_jogging_cycle_callback(void);                         // jogging cycle main loop
 stat_t cm_jogging_cycle_start(uint8_t axis);                    // {"jogx":-100.3}
+stat_t cm_jogging_velocity(uint8_t axis, float velocity);       // {"jgv":{"x":1200}}
 float cm_get_jogging_dest(void);                                // get jogging destination
 
 // Alarm management (alarm.cpp)
@@ -541,6 +555,7 @@ stat_t cm_get_prb (nvObj_t *nv);        // get probe result for axis
 stat_t cm_get_probe_input(nvObj_t *nv);
 stat_t cm_set_probe_input(nvObj_t *nv);
 stat_t cm_run_jog(nvObj_t *nv);         // start jogging cycle
+stat_t cm_run_jv(nvObj_t *nv);          // start, steer or keep alive a velocity jog
 
 stat_t cm_get_unit(nvObj_t *nv);        // get unit mode
 stat_t cm_get_coor(nvObj_t *nv);        // get coordinate system in effect
@@ -610,6 +625,16 @@ stat_t cm_get_lb(nvObj_t *nv);          // get homing latch backoff
 stat_t cm_set_lb(nvObj_t *nv);          // set homing latch backoff
 stat_t cm_get_zb(nvObj_t *nv);          // get homing zero backoff
 stat_t cm_set_zb(nvObj_t *nv);          // set homing zero backoff
+stat_t cm_get_is(nvObj_t *nv);          // get input shaper type
+stat_t cm_set_is(nvObj_t *nv);          // set input shaper type
+stat_t cm_get_if(nvObj_t *nv);          // get input shaper frequency
+stat_t cm_set_if(nvObj_t *nv);          // set input shaper frequency
+stat_t cm_get_id(nvObj_t *nv);          // get input shaper damping
+stat_t cm_set_id(nvObj_t *nv);          // set input shaper damping
+stat_t cm_get_pa(nvObj_t *nv);          // get pressure advance
+stat_t cm_set_pa(nvObj_t *nv);          // set pressure advance
+stat_t cm_get_ps(nvObj_t *nv);          // get pressure advance smooth time
+stat_t cm_set_ps(nvObj_t *nv);          // set pressure advance smooth time
 
 stat_t cm_get_jt(nvObj_t *nv);          // get junction integration time constant
 stat_t cm_set_jt(nvObj_t *nv);          // set junction integration time constant
@@ -619,6 +644,10 @@ stat_t cm_get_zl(nvObj_t *nv);          // get feedhold Z lift
 stat_t cm_set_zl(nvObj_t *nv);          // set feedhold Z lift
 stat_t cm_get_sl(nvObj_t *nv);          // get soft limit enable
 stat_t cm_set_sl(nvObj_t *nv);          // set soft limit enable
+stat_t cm_get_hsim(nvObj_t *nv);        // get simultaneous homing enable
+stat_t cm_set_hsim(nvObj_t *nv);        // set simultaneous homing enable
+stat_t cm_get_jvt(nvObj_t *nv);         // get velocity jog keep-alive time
+stat_t cm_set_jvt(nvObj_t *nv);         // set velocity jog keep-alive time
 stat_t cm_get_lim(nvObj_t *nv);         // get hard limit enable
 stat_t cm_set_lim(nvObj_t *nv);         // set hard limit enable
 
@@ -695,6 +724,8 @@ stat_t cm_set_gdi(nvObj_t *nv);         // set gcode default distance mode
     void cm_print_ct(nvObj_t *nv);
     void cm_print_zl(nvObj_t *nv);
     void cm_print_sl(nvObj_t *nv);
+    void cm_print_hsim(nvObj_t *nv);
+    void cm_print_jvt(nvObj_t *nv);
     void cm_print_lim(nvObj_t *nv);
     void cm_print_saf(nvObj_t *nv);
 
@@ -722,6 +753,11 @@ stat_t cm_set_gdi(nvObj_t *nv);         // set gcode default distance mode
     void cm_print_lv(nvObj_t *nv);
     void cm_print_lb(nvObj_t *nv);
     void cm_print_zb(nvObj_t *nv);
+    void cm_print_is(nvObj_t *nv);
+    void cm_print_if(nvObj_t *nv);
+    void cm_print_id(nvObj_t *nv);
+    void cm_print_pa(nvObj_t *nv);
+    void cm_print_ps(nvObj_t *nv);
     void cm_print_cofs(nvObj_t *nv);
     void cm_print_cpos(nvObj_t *nv);
 
@@ -763,6 +799,8 @@ stat_t cm_set_gdi(nvObj_t *nv);         // set gcode default distance mode
     #define cm_print_ct tx_print_stub
     #define cm_print_zl tx_print_stub
     #define cm_print_sl tx_print_stub
+    #define cm_print_hsim tx_print_stub
+    #define cm_print_jvt tx_print_stub
     #define cm_print_lim tx_print_stub
     #define cm_print_saf tx_print_stub
 
@@ -791,6 +829,11 @@ stat_t cm_set_gdi(nvObj_t *nv);         // set gcode default distance mode
     #define cm_print_lv tx_print_stub
     #define cm_print_lb tx_print_stub
     #define cm_print_zb tx_print_stub
+    #define cm_print_is tx_print_stub
+    #define cm_print_if tx_print_stub
+    #define cm_print_id tx_print_stub
+    #define cm_print_pa tx_print_stub
+    #define cm_print_ps tx_print_stub
     #define cm_print_cofs tx_print_stub
     #define cm_print_cpos tx_print_stub
 
@@ -121,14 +121,9 @@ void config_init()
     read_persistent_value(nv);
     if (fp_NE(nv->value_flt, G2CORE_FIRMWARE_BUILD)) {   // case (1) NVM is not setup or not in revision
         _set_defa(nv, false);
+    } else if (read_persistent_values(nv, nv_set) != STAT_OK) {  // case (2) restore NVM in one pass
+        _set_defa(nv, false);                       // NVM went bad mid-read - fall back to defaults
     } else {
-        for (nv->index=0; nv_index_is_single(nv->index); nv->index++) {
-            if (GET_TABLE_BYTE(flags) & F_INITIALIZE) {
-                strncpy(nv->token, cfgArray[nv->index].token, TOKEN_LEN); // read the token from the array
-                read_persistent_value(nv);
-                nv_set(nv);
-            }
-        }
         sr_init_status_report();                    // reset status reports
     }
     rpt_print_loading_configs_message();
@@ -354,9 +349,11 @@ stat_t get_grp(nvObj_t *nv)
     nv_reset_nv_list();                             // start with a clean list
     strcpy(nv->token, group);                       // re-write the group string
     nv->valuetype = TYPE_PARENT;                    // make first object the parent
-    for (index_t i=0; nv_index_is_single(i); i++) {
-        if (strcmp(group, cfgArray[i].group) != 0) { continue; }
-        (++nv)->index = i;
+
+    index_t count;                                  // group members are precomputed in table order
+    const uint16_t *members = nv_group_members(nv_get_index("", group), &count);
+    for (index_t i=0; i < count; i++) {
+        (++nv)->index = members[i];
         nv_get_nvObj(nv);
     }
     return (STAT_OK);
@@ -400,41 +397,16 @@ stat_t set_grp(nvObj_t *nv)
 
 /* nv_get_index() - get index from mnenonic token + group
  *
- * nv_get_index() is the most expensive routine in the whole config. It does a
- * linear table scan of the strings, which of course could be further
- * optimized with indexes or hashing.
+ * nv_get_index() used to be the most expensive routine in the whole config as it did
+ * a linear table scan of the strings. It now probes the hashed token index that is
+ * built from cfgArray at compile time - see nv_index_lookup() in config_app.cpp.
  */
 index_t nv_get_index(const char *group, const char *token)
 {
-    char c;
     char str[TOKEN_LEN + GROUP_LEN+1];    // should actually never be more than TOKEN_LEN+1
     strncpy(str, group, GROUP_LEN+1);
     strncat(str, token, TOKEN_LEN+1);
-
-    index_t i;
-    index_t index_max = nv_index_max();
-
-    for (i=0; i < index_max; i++) {
-        if ((c = GET_TOKEN_BYTE(token[0])) != str[0]) {    continue; }              // 1st character mismatch
-        if ((c = GET_TOKEN_BYTE(token[1])) == NUL) { if (str[1] == NUL) return(i);} // one character match
-        if (c != str[1]) continue;                                                  // 2nd character mismatch
-        if ((c = GET_TOKEN_BYTE(token[2])) == NUL) { if (str[2] == NUL) return(i);} // two character match
-        if (c != str[2]) continue;                                                  // 3rd character mismatch
-        if ((c = GET_TOKEN_BYTE(token[3])) == NUL) { if (str[3] == NUL) return(i);} // three character match
-        if (c != str[3]) continue;                                                  // 4th character mismatch
-        if ((c = GET_TOKEN_BYTE(token[4])) == NUL) { if (str[4] == NUL) return(i);} // four character match
-        if (c != str[4]) continue;                                                  // 5th character mismatch
-        if ((c = GET_TOKEN_BYTE(token[5])) == NUL) { if (str[5] == NUL) return(i);} // four character match
-        if (c != str[5]) continue;                                                  // 6th character mismatch
-        if ((c = GET_TOKEN_BYTE(token[6])) == NUL) { if (str[6] == NUL) return(i);} // four character match
-        if (c != str[6]) continue;                                                  // 7th character mismatch
-        if ((c = GET_TOKEN_BYTE(token[7])) == NUL) { if (str[7] == NUL) return(i);} // four character match
-        if (c != str[7]) continue;                                                  // 8th character mismatch
-        if ((c = GET_TOKEN_BYTE(token[8])) == NUL) { if (str[8] == NUL) return(i);} // four character match
-        if (c != str[8]) continue;                                                  // 9th character mismatch
-        return (i);                                                                 // five character match
-    }
-    return (NO_MATCH);
+    return (nv_index_lookup(str));
 }
 
 /*
@@ -156,9 +156,10 @@
  *
  *  It's the responsibility of the object creator to set the index. Downstream functions
  *  all expect a valid index. Set the index by calling nv_get_index(). This also validates
- *  the token and group if no lookup exists. Setting the index is an expensive operation
- *  (linear table scan), so there are some exceptions where the index does not need to be set.
- *  These cases are put in the code, commented out, and explained.
+ *  the token and group if no lookup exists. Setting the index is a hash probe into an index
+ *  that is built from cfgArray at compile time (see config_app.cpp), so it's cheap, but
+ *  there are still some cases where the index does not need to be set. These cases are put
+ *  in the code, commented out, and explained.
  */
 /*  --- Other Notes:---
  *
@@ -329,6 +330,21 @@ typedef struct cfgItem {
     float def_value;                    // default value for config item
 } cfgItem_t;
 
+/*
+ * nv_hash_token() - FNV-1a hash of a full token (group prefix included)
+ *
+ *  Shared by the compile-time token index in config_app.cpp and the runtime lookup,
+ *  so both must see the same TOKEN_LEN limit.
+ */
+constexpr uint32_t nv_hash_token(const char *token)
+{
+    uint32_t hash = 2166136261UL;
+    for (uint8_t i=0; (i < TOKEN_LEN) && (token[i] != '\0'); i++) {
+        hash = (hash ^ (uint8_t)token[i]) * 16777619UL;
+    }
+    return (hash);
+}
+
 /**** static allocation and definitions ****/
 
 extern nvStr_t nvStr;
@@ -361,6 +377,8 @@ index_t nv_index_max(void);             // (see config_app.c)
 bool nv_index_is_single(index_t index); // (see config_app.c)
 bool nv_index_is_group(index_t index);  // (see config_app.c)
 bool nv_index_lt_groups(index_t index); // (see config_app.c)
+index_t nv_index_lookup(const char *str);                         // (see config_app.c)
+const uint16_t *nv_group_members(index_t index, index_t *count);  // (see config_app.c)
 bool nv_group_is_prefixed(char *group);
 
 // generic internal functions and accessors
@@ -109,7 +109,7 @@ static stat_t get_tick(nvObj_t *nv);        // get system tick count
  *    and convert_outgoing_float(). Apply conversion flags to all axes, not just linear,
  *    as rotary axes may be treated as linear if in radius mode, so the flag is needed.
  */
-const cfgItem_t cfgArray[] = {
+constexpr cfgItem_t cfgArray[] = {
 
     // group token flags p, print_func,   get_func,   set_func, get/set target,    default value
     { "sys", "fb", _fn,  2, hw_print_fb,  hw_get_fb,  set_ro, nullptr, 0 },   // MUST BE FIRST for persistence checking!
@@ -214,6 +214,15 @@ const cfgItem_t cfgArray[] = {
     { "jog","joga",_f0, 5, tx_print_nul, get_nul, cm_run_jog, nullptr, 0},    // jog in A axis
     { "jog","jogb",_f0, 5, tx_print_nul, get_nul, cm_run_jog, nullptr, 0},    // jog in B axis
     { "jog","jogc",_f0, 5, tx_print_nul, get_nul, cm_run_jog, nullptr, 0},    // jog in C axis
+    { "jgv","jgvx",_f0, 0, tx_print_nul, get_nul, cm_run_jv, nullptr, 0},     // jog velocity in X axis
+    { "jgv","jgvy",_f0, 0, tx_print_nul, get_nul, cm_run_jv, nullptr, 0},     // jog velocity in Y axis
+    { "jgv","jgvz",_f0, 0, tx_print_nul, get_nul, cm_run_jv, nullptr, 0},     // jog velocity in Z axis
+    { "jgv","jgvu",_f0, 0, tx_print_nul, get_nul, cm_run_jv, nullptr, 0},     // jog velocity in U axis
+    { "jgv","jgvv",_f0, 0, tx_print_nul, get_nul, cm_run_jv, nullptr, 0},     // jog velocity in V axis
+    { "jgv","jgvw",_f0, 0, tx_print_nul, get_nul, cm_run_jv, nullptr, 0},     // jog velocity in W axis
+    { "jgv","jgva",_f0, 0, tx_print_nul, get_nul, cm_run_jv, nullptr, 0},     // jog velocity in A axis
+    { "jgv","jgvb",_f0, 0, tx_print_nul, get_nul, cm_run_jv, nullptr, 0},     // jog velocity in B axis
+    { "jgv","jgvc",_f0, 0, tx_print_nul, get_nul, cm_run_jv, nullptr, 0},     // jog velocity in C axis
 
 	{ "pwr","pwr1",_f0, 3, st_print_pwr, st_get_pwr, set_ro, nullptr, 0},	  // motor power readouts
 	{ "pwr","pwr2",_f0, 3, st_print_pwr, st_get_pwr, set_ro, nullptr, 0},
@@ -248,6 +257,7 @@ const cfgItem_t cfgArray[] = {
     { "1","1ep", _iip,  0, st_print_ep, st_get_ep, st_set_ep, nullptr, M1_ENABLE_POLARITY },
     { "1","1sp", _iip,  0, st_print_sp, st_get_sp, st_set_sp, nullptr, M1_STEP_POLARITY },
     { "1","1pi", _fip,  3, st_print_pi, st_get_pi, st_set_pi, nullptr, M1_POWER_LEVEL_IDLE },
+    { "1","1hi", _iip,  0, st_print_hi, st_get_hi, st_set_hi, nullptr, M1_HOMING_INPUT },
 //  { "1","1mt", _fip,  2, st_print_mt, st_get_mt, st_set_mt, nullptr, M1_MOTOR_TIMEOUT },
 #ifdef MOTOR_1_IS_TRINAMIC
     { "1","1ts",  _i0,  0, tx_print_nul, motor_1.get_ts_fn,  set_ro,              &motor_1, 0 },
@@ -258,6 +268,7 @@ const cfgItem_t cfgArray[] = {
     { "1","1sgr", _i0,  0, tx_print_nul, motor_1.get_sgr_fn, set_ro,              &motor_1, 0 },
     { "1","1csa", _i0,  0, tx_print_nul, motor_1.get_csa_fn, set_ro,              &motor_1, 0 },
     { "1","1sgs", _i0,  0, tx_print_nul, motor_1.get_sgs_fn, set_ro,              &motor_1, 0 },
+    { "1","1ot",  _i0,  0, tx_print_nul, motor_1.get_ot_fn,  set_ro,              &motor_1, 0 },
     { "1","1tbl", _iip, 0, tx_print_nul, motor_1.get_tbl_fn, motor_1.set_tbl_fn,  &motor_1, M1_TMC2130_TBL },
     { "1","1pgrd",_iip, 0, tx_print_nul, motor_1.get_pgrd_fn,motor_1.set_pgrd_fn, &motor_1, M1_TMC2130_PWM_GRAD },
     { "1","1pamp",_iip, 0, tx_print_nul, motor_1.get_pamp_fn,motor_1.set_pamp_fn, &motor_1, M1_TMC2130_PWM_AMPL },
@@ -282,6 +293,7 @@ const cfgItem_t cfgArray[] = {
     { "2","2ep", _iip,  0, st_print_ep, st_get_ep, st_set_ep, nullptr, M2_ENABLE_POLARITY },
     { "2","2sp", _iip,  0, st_print_sp, st_get_sp, st_set_sp, nullptr, M2_STEP_POLARITY },
     { "2","2pi", _fip,  3, st_print_pi, st_get_pi, st_set_pi, nullptr, M2_POWER_LEVEL_IDLE },
+    { "2","2hi", _iip,  0, st_print_hi, st_get_hi, st_set_hi, nullptr, M2_HOMING_INPUT },
 //  { "2","2mt", _fip,  2, st_print_mt, st_get_mt, st_set_mt, nullptr, M2_MOTOR_TIMEOUT },
 #ifdef MOTOR_2_IS_TRINAMIC
     { "2","2ts",  _i0,  0, tx_print_nul, motor_2.get_ts_fn,  set_ro,              &motor_2, 0 },
@@ -292,6 +304,7 @@ const cfgItem_t cfgArray[] = {
     { "2","2sgr", _i0,  0, tx_print_nul, motor_2.get_sgr_fn, set_ro,              &motor_2, 0 },
     { "2","2csa", _i0,  0, tx_print_nul, motor_2.get_csa_fn, set_ro,              &motor_2, 0 },
     { "2","2sgs", _i0,  0, tx_print_nul, motor_2.get_sgs_fn, set_ro,              &motor_2, 0 },
+    { "2","2ot",  _i0,  0, tx_print_nul, motor_2.get_ot_fn,  set_ro,              &motor_2, 0 },
     { "2","2tbl", _iip, 0, tx_print_nul, motor_2.get_tbl_fn, motor_2.set_tbl_fn,  &motor_2, M2_TMC2130_TBL },
     { "2","2pgrd",_iip, 0, tx_print_nul, motor_2.get_pgrd_fn,motor_2.set_pgrd_fn, &motor_2, M2_TMC2130_PWM_GRAD },
     { "2","2pamp",_iip, 0, tx_print_nul, motor_2.get_pamp_fn,motor_2.set_pamp_fn, &motor_2, M2_TMC2130_PWM_AMPL },
@@ -316,6 +329,7 @@ const cfgItem_t cfgArray[] = {
     { "3","3ep", _iip,  0, st_print_ep, st_get_ep, st_set_ep, nullptr, M3_ENABLE_POLARITY },
     { "3","3sp", _iip,  0, st_print_sp, st_get_sp, st_set_sp, nullptr, M3_STEP_POLARITY },
     { "3","3pi", _fip,  3, st_print_pi, st_get_pi, st_set_pi, nullptr, M3_POWER_LEVEL_IDLE },
+    { "3","3hi", _iip,  0, st_print_hi, st_get_hi, st_set_hi, nullptr, M3_HOMING_INPUT },
 //  { "3","3mt", _fip,  2, st_print_mt, st_get_mt, st_set_mt, nullptr, M3_MOTOR_TIMEOUT },
 #ifdef MOTOR_3_IS_TRINAMIC
     { "3","3ts",  _i0,  0, tx_print_nul, motor_3.get_ts_fn,  set_ro,              &motor_3, 0 },
@@ -326,6 +340,7 @@ const cfgItem_t cfgArray[] = {
     { "3","3sgr", _i0,  0, tx_print_nul, motor_3.get_sgr_fn, set_ro,              &motor_3, 0 },
     { "3","3csa", _i0,  0, tx_print_nul, motor_3.get_csa_fn, set_ro,              &motor_3, 0 },
     { "3","3sgs", _i0,  0, tx_print_nul, motor_3.get_sgs_fn, set_ro,              &motor_3, 0 },
+    { "3","3ot",  _i0,  0, tx_print_nul, motor_3.get_ot_fn,  set_ro,              &motor_3, 0 },
     { "3","3tbl", _iip, 0, tx_print_nul, motor_3.get_tbl_fn, motor_3.set_tbl_fn,  &motor_3, M3_TMC2130_TBL },
     { "3","3pgrd",_iip, 0, tx_print_nul, motor_3.get_pgrd_fn,motor_3.set_pgrd_fn, &motor_3, M3_TMC2130_PWM_GRAD },
     { "3","3pamp",_iip, 0, tx_print_nul, motor_3.get_pamp_fn,motor_3.set_pamp_fn, &motor_3, M3_TMC2130_PWM_AMPL },
@@ -350,6 +365,7 @@ const cfgItem_t cfgArray[] = {
     { "4","4ep", _iip,  0, st_print_ep, st_get_ep, st_set_ep, nullptr, M4_ENABLE_POLARITY },
     { "4","4sp", _iip,  0, st_print_sp, st_get_sp, st_set_sp, nullptr, M4_STEP_POLARITY },
     { "4","4pi", _fip,  3, st_print_pi, st_get_pi, st_set_pi, nullptr, M4_POWER_LEVEL_IDLE },
+    { "4","4hi", _iip,  0, st_print_hi, st_get_hi, st_set_hi, nullptr, M4_HOMING_INPUT },
 //  { "4","4mt", _fip,  2, st_print_mt, st_get_mt, st_set_mt, nullptr, M4_MOTOR_TIMEOUT },
 #ifdef MOTOR_4_IS_TRINAMIC
     { "4","4ts",  _i0,  0, tx_print_nul, motor_4.get_ts_fn,  set_ro,              &motor_4, 0 },
@@ -360,6 +376,7 @@ const cfgItem_t cfgArray[] = {
     { "4","4sgr", _i0,  0, tx_print_nul, motor_4.get_sgr_fn, set_ro,              &motor_4, 0 },
     { "4","4csa", _i0,  0, tx_print_nul, motor_4.get_csa_fn, set_ro,              &motor_4, 0 },
     { "4","4sgs", _i0,  0, tx_print_nul, motor_4.get_sgs_fn, set_ro,              &motor_4, 0 },
+    { "4","4ot",  _i0,  0, tx_print_nul, motor_4.get_ot_fn,  set_ro,              &motor_4, 0 },
     { "4","4tbl", _iip, 0, tx_print_nul, motor_4.get_tbl_fn, motor_4.set_tbl_fn,  &motor_4, M4_TMC2130_TBL },
     { "4","4pgrd",_iip, 0, tx_print_nul, motor_4.get_pgrd_fn,motor_4.set_pgrd_fn, &motor_4, M4_TMC2130_PWM_GRAD },
     { "4","4pamp",_iip, 0, tx_print_nul, motor_4.get_pamp_fn,motor_4.set_pamp_fn, &motor_4, M4_TMC2130_PWM_AMPL },
@@ -384,6 +401,7 @@ const cfgItem_t cfgArray[] = {
     { "5","5ep", _iip,  0, st_print_ep, st_get_ep, st_set_ep, nullptr, M5_ENABLE_POLARITY },
     { "5","5sp", _iip,  0, st_print_sp, st_get_sp, st_set_sp, nullptr, M5_STEP_POLARITY },
     { "5","5pi", _fip,  3, st_print_pi, st_get_pi, st_set_pi, nullptr, M5_POWER_LEVEL_IDLE },
+    { "5","5hi", _iip,  0, st_print_hi, st_get_hi, st_set_hi, nullptr, M5_HOMING_INPUT },
 //  { "5","5mt", _fip,  2, st_print_mt, st_get_mt, st_set_mt, nullptr, M5_MOTOR_TIMEOUT },
 #ifdef MOTOR_5_IS_TRINAMIC
     { "5","5ts",  _i0,  0, tx_print_nul, motor_5.get_ts_fn,  set_ro,              &motor_5, 0 },
@@ -394,6 +412,7 @@ const cfgItem_t cfgArray[] = {
     { "5","5sgr", _i0,  0, tx_print_nul, motor_5.get_sgr_fn, set_ro,              &motor_5, 0 },
     { "5","5csa", _i0,  0, tx_print_nul, motor_5.get_csa_fn, set_ro,              &motor_5, 0 },
     { "5","5sgs", _i0,  0, tx_print_nul, motor_5.get_sgs_fn, set_ro,              &motor_5, 0 },
+    { "5","5ot",  _i0,  0, tx_print_nul, motor_5.get_ot_fn,  set_ro,              &motor_5, 0 },
     { "5","5tbl", _iip, 0, tx_print_nul, motor_5.get_tbl_fn, motor_5.set_tbl_fn,  &motor_5, M5_TMC2130_TBL },
     { "5","5pgrd",_iip, 0, tx_print_nul, motor_5.get_pgrd_fn,motor_5.set_pgrd_fn, &motor_5, M5_TMC2130_PWM_GRAD },
     { "5","5pamp",_iip, 0, tx_print_nul, motor_5.get_pamp_fn,motor_5.set_pamp_fn, &motor_5, M5_TMC2130_PWM_AMPL },
@@ -418,6 +437,7 @@ const cfgItem_t cfgArray[] = {
     { "6","6ep", _iip,  0, st_print_ep, st_get_ep, st_set_ep, nullptr, M6_ENABLE_POLARITY },
     { "6","6sp", _iip,  0, st_print_sp, st_get_sp, st_set_sp, nullptr, M6_STEP_POLARITY },
     { "6","6pi", _fip,  3, st_print_pi, st_get_pi, st_set_pi, nullptr, M6_POWER_LEVEL_IDLE },
+    { "6","6hi", _iip,  0, st_print_hi, st_get_hi, st_set_hi, nullptr, M6_HOMING_INPUT },
 //  { "6","6mt", _fip,  2, st_print_mt, st_get_mt, st_set_mt, nullptr, M6_MOTOR_TIMEOUT },
 #ifdef MOTOR_6_IS_TRINAMIC
     { "6","6ts",  _i0,  0, tx_print_nul, motor_6.get_ts_fn,  set_ro,              &motor_6, 0 },
@@ -428,6 +448,7 @@ const cfgItem_t cfgArray[] = {
     { "6","6sgr", _i0,  0, tx_print_nul, motor_6.get_sgr_fn, set_ro,              &motor_6, 0 },
     { "6","6csa", _i0,  0, tx_print_nul, motor_6.get_csa_fn, set_ro,              &motor_6, 0 },
     { "6","6sgs", _i0,  0, tx_print_nul, motor_6.get_sgs_fn, set_ro,              &motor_6, 0 },
+    { "6","6ot",  _i0,  0, tx_print_nul, motor_6.get_ot_fn,  set_ro,              &motor_6, 0 },
     { "6","6tbl", _iip, 0, tx_print_nul, motor_6.get_tbl_fn, motor_6.set_tbl_fn,  &motor_6, M6_TMC2130_TBL },
     { "6","6pgrd",_iip, 0, tx_print_nul, motor_6.get_pgrd_fn,motor_6.set_pgrd_fn, &motor_6, M6_TMC2130_PWM_GRAD },
     { "6","6pamp",_iip, 0, tx_print_nul, motor_6.get_pamp_fn,motor_6.set_pamp_fn, &motor_6, M6_TMC2130_PWM_AMPL },
@@ -456,6 +477,9 @@ const cfgItem_t cfgArray[] = {
     { "x","xlv",_fipc, 2, cm_print_lv, cm_get_lv, cm_set_lv, nullptr, X_LATCH_VELOCITY },
     { "x","xlb",_fipc, 5, cm_print_lb, cm_get_lb, cm_set_lb, nullptr, X_LATCH_BACKOFF },
     { "x","xzb",_fipc, 5, cm_print_zb, cm_get_zb, cm_set_zb, nullptr, X_ZERO_BACKOFF },
+    { "x","xis",_iip,  0, cm_print_is, cm_get_is, cm_set_is, nullptr, X_SHAPER_TYPE },
+    { "x","xif",_fip,  1, cm_print_if, cm_get_if, cm_set_if, nullptr, X_SHAPER_FREQUENCY },
+    { "x","xid",_fip,  3, cm_print_id, cm_get_id, cm_set_id, nullptr, X_SHAPER_DAMPING },
 
     { "y","yam",_iip,  0, cm_print_am, cm_get_am, cm_set_am, nullptr, Y_AXIS_MODE },
     { "y","yvm",_fipc, 0, cm_print_vm, cm_get_vm, cm_set_vm, nullptr, Y_VELOCITY_MAX },
@@ -470,6 +494,9 @@ const cfgItem_t cfgArray[] = {
     { "y","ylv",_fipc, 2, cm_print_lv, cm_get_lv, cm_set_lv, nullptr, Y_LATCH_VELOCITY },
     { "y","ylb",_fipc, 5, cm_print_lb, cm_get_lb, cm_set_lb, nullptr, Y_LATCH_BACKOFF },
     { "y","yzb",_fipc, 5, cm_print_zb, cm_get_zb, cm_set_zb, nullptr, Y_ZERO_BACKOFF },
+    { "y","yis",_iip,  0, cm_print_is, cm_get_is, cm_set_is, nullptr, Y_SHAPER_TYPE },
+    { "y","yif",_fip,  1, cm_print_if, cm_get_if, cm_set_if, nullptr, Y_SHAPER_FREQUENCY },
+    { "y","yid",_fip,  3, cm_print_id, cm_get_id, cm_set_id, nullptr, Y_SHAPER_DAMPING },
 
     { "z","zam",_iip,  0, cm_print_am, cm_get_am, cm_set_am, nullptr, Z_AXIS_MODE },
     { "z","zvm",_fipc, 0, cm_print_vm, cm_get_vm, cm_set_vm, nullptr, Z_VELOCITY_MAX },
@@ -484,6 +511,9 @@ const cfgItem_t cfgArray[] = {
     { "z","zlv",_fipc, 2, cm_print_lv, cm_get_lv, cm_set_lv, nullptr, Z_LATCH_VELOCITY },
     { "z","zlb",_fipc, 5, cm_print_lb, cm_get_lb, cm_set_lb, nullptr, Z_LATCH_BACKOFF },
     { "z","zzb",_fipc, 5, cm_print_zb, cm_get_zb, cm_set_zb, nullptr, Z_ZERO_BACKOFF },
+    { "z","zis",_iip,  0, cm_print_is, cm_get_is, cm_set_is, nullptr, Z_SHAPER_TYPE },
+    { "z","zif",_fip,  1, cm_print_if, cm_get_if, cm_set_if, nullptr, Z_SHAPER_FREQUENCY },
+    { "z","zid",_fip,  3, cm_print_id, cm_get_id, cm_set_id, nullptr, Z_SHAPER_DAMPING },
 
 #if (AXES == 9)
     { "u","uam",_iip,  0, cm_print_am, cm_get_am, cm_set_am, nullptr, U_AXIS_MODE },
@@ -499,6 +529,9 @@ const cfgItem_t cfgArray[] = {
     { "u","ulv",_fipc, 2, cm_print_lv, cm_get_lv, cm_set_lv, nullptr, U_LATCH_VELOCITY },
     { "u","ulb",_fipc, 5, cm_print_lb, cm_get_lb, cm_set_lb, nullptr, U_LATCH_BACKOFF },
     { "u","uzb",_fipc, 5, cm_print_zb, cm_get_zb, cm_set_zb, nullptr, U_ZERO_BACKOFF },
+    { "u","uis",_iip,  0, cm_print_is, cm_get_is, cm_set_is, nullptr, U_SHAPER_TYPE },
+    { "u","uif",_fip,  1, cm_print_if, cm_get_if, cm_set_if, nullptr, U_SHAPER_FREQUENCY },
+    { "u","uid",_fip,  3, cm_print_id, cm_get_id, cm_set_id, nullptr, U_SHAPER_DAMPING },
 
     { "v","vam",_iip,  0, cm_print_am, cm_get_am, cm_set_am, nullptr, V_AXIS_MODE },
     { "v","vvm",_fipc, 0, cm_print_vm, cm_get_vm, cm_set_vm, nullptr, V_VELOCITY_MAX },
@@ -513,6 +546,9 @@ const cfgItem_t cfgArray[] = {
     { "v","vlv",_fipc, 2, cm_print_lv, cm_get_lv, cm_set_lv, nullptr, V_LATCH_VELOCITY },
     { "v","vlb",_fipc, 5, cm_print_lb, cm_get_lb, cm_set_lb, nullptr, V_LATCH_BACKOFF },
     { "v","vzb",_fipc, 5, cm_print_zb, cm_get_zb, cm_set_zb, nullptr, V_ZERO_BACKOFF },
+    { "v","vis",_iip,  0, cm_print_is, cm_get_is, cm_set_is, nullptr, V_SHAPER_TYPE },
+    { "v","vif",_fip,  1, cm_print_if, cm_get_if, cm_set_if, nullptr, V_SHAPER_FREQUENCY },
+    { "v","vid",_fip,  3, cm_print_id, cm_get_id, cm_set_id, nullptr, V_SHAPER_DAMPING },
 
     { "w","wam",_iip,  0, cm_print_am, cm_get_am, cm_set_am, nullptr, W_AXIS_MODE },
     { "w","wvm",_fipc, 0, cm_print_vm, cm_get_vm, cm_set_vm, nullptr, W_VELOCITY_MAX },
@@ -527,6 +563,9 @@ const cfgItem_t cfgArray[] = {
     { "w","wlv",_fipc, 2, cm_print_lv, cm_get_lv, cm_set_lv, nullptr, W_LATCH_VELOCITY },
     { "w","wlb",_fipc, 5, cm_print_lb, cm_get_lb, cm_set_lb, nullptr, W_LATCH_BACKOFF },
     { "w","wzb",_fipc, 5, cm_print_zb, cm_get_zb, cm_set_zb, nullptr, W_ZERO_BACKOFF },
+    { "w","wis",_iip,  0, cm_print_is, cm_get_is, cm_set_is, nullptr, W_SHAPER_TYPE },
+    { "w","wif",_fip,  1, cm_print_if, cm_get_if, cm_set_if, nullptr, W_SHAPER_FREQUENCY },
+    { "w","wid",_fip,  3, cm_print_id, cm_get_id, cm_set_id, nullptr, W_SHAPER_DAMPING },
 #endif
 
     { "a","aam",_iip,  0, cm_print_am, cm_get_am, cm_set_am, nullptr, A_AXIS_MODE },
@@ -543,6 +582,11 @@ const cfgItem_t cfgArray[] = {
     { "a","alv",_fipc, 2, cm_print_lv, cm_get_lv, cm_set_lv, nullptr, A_LATCH_VELOCITY },
     { "a","alb",_fipc, 5, cm_print_lb, cm_get_lb, cm_set_lb, nullptr, A_LATCH_BACKOFF },
     { "a","azb",_fipc, 5, cm_print_zb, cm_get_zb, cm_set_zb, nullptr, A_ZERO_BACKOFF },
+    { "a","ais",_iip,  0, cm_print_is, cm_get_is, cm_set_is, nullptr, A_SHAPER_TYPE },
+    { "a","aif",_fip,  1, cm_print_if, cm_get_if, cm_set_if, nullptr, A_SHAPER_FREQUENCY },
+    { "a","aid",_fip,  3, cm_print_id, cm_get_id, cm_set_id, nullptr, A_SHAPER_DAMPING },
+    { "a","apa",_fip,  3, cm_print_pa, cm_get_pa, cm_set_pa, nullptr, A_PRESSURE_ADVANCE },
+    { "a","aps",_fip,  3, cm_print_ps, cm_get_ps, cm_set_ps, nullptr, A_PRESSURE_ADVANCE_SMOOTH },
 
     { "b","bam",_iip,  0, cm_print_am, cm_get_am, cm_set_am, nullptr, B_AXIS_MODE },
     { "b","bvm",_fipc, 0, cm_print_vm, cm_get_vm, cm_set_vm, nullptr, B_VELOCITY_MAX },
@@ -558,6 +602,11 @@ const cfgItem_t cfgArray[] = {
     { "b","blv",_fipc, 2, cm_print_lv, cm_get_lv, cm_set_lv, nullptr, B_LATCH_VELOCITY },
     { "b","blb",_fipc, 5, cm_print_lb, cm_get_lb, cm_set_lb, nullptr, B_LATCH_BACKOFF },
     { "b","bzb",_fipc, 5, cm_print_zb, cm_get_zb, cm_set_zb, nullptr, B_ZERO_BACKOFF },
+    { "b","bis",_iip,  0, cm_print_is, cm_get_is, cm_set_is, nullptr, B_SHAPER_TYPE },
+    { "b","bif",_fip,  1, cm_print_if, cm_get_if, cm_set_if, nullptr, B_SHAPER_FREQUENCY },
+    { "b","bid",_fip,  3, cm_print_id, cm_get_id, cm_set_id, nullptr, B_SHAPER_DAMPING },
+    { "b","bpa",_fip,  3, cm_print_pa, cm_get_pa, cm_set_pa, nullptr, B_PRESSURE_ADVANCE },
+    { "b","bps",_fip,  3, cm_print_ps, cm_get_ps, cm_set_ps, nullptr, B_PRESSURE_ADVANCE_SMOOTH },
 
     { "c","cam",_iip,  0, cm_print_am, cm_get_am, cm_set_am, nullptr, C_AXIS_MODE },
     { "c","cvm",_fipc, 0, cm_print_vm, cm_get_vm, cm_set_vm, nullptr, C_VELOCITY_MAX },
@@ -573,6 +622,11 @@ const cfgItem_t cfgArray[] = {
     { "c","clv",_fipc, 2, cm_print_lv, cm_get_lv, cm_set_lv, nullptr, C_LATCH_VELOCITY },
     { "c","clb",_fipc, 5, cm_print_lb, cm_get_lb, cm_set_lb, nullptr, C_LATCH_BACKOFF },
     { "c","czb",_fipc, 5, cm_print_zb, cm_get_zb, cm_set_zb, nullptr, C_ZERO_BACKOFF },
+    { "c","cis",_iip,  0, cm_print_is, cm_get_is, cm_set_is, nullptr, C_SHAPER_TYPE },
+    { "c","cif",_fip,  1, cm_print_if, cm_get_if, cm_set_if, nullptr, C_SHAPER_FREQUENCY },
+    { "c","cid",_fip,  3, cm_print_id, cm_get_id, cm_set_id, nullptr, C_SHAPER_DAMPING },
+    { "c","cpa",_fip,  3, cm_print_pa, cm_get_pa, cm_set_pa, nullptr, C_PRESSURE_ADVANCE },
+    { "c","cps",_fip,  3, cm_print_ps, cm_get_ps, cm_set_ps, nullptr, C_PRESSURE_ADVANCE_SMOOTH },
 
 
 
@@ -861,6 +915,21 @@ const cfgItem_t cfgArray[] = {
     { "pid3","pid3p",_fip, 3, tx_print_nul, cm_get_pid_p, set_ro, nullptr, 0 },
     { "pid3","pid3i",_fip, 5, tx_print_nul, cm_get_pid_i, set_ro, nullptr, 0 },
     { "pid3","pid3d",_fip, 5, tx_print_nul, cm_get_pid_d, set_ro, nullptr, 0 },
+#if (HEATERS >= 4)
+    { "pid4","pid4p",_fip, 3, tx_print_nul, cm_get_pid_p, set_ro, nullptr, 0 },
+    { "pid4","pid4i",_fip, 5, tx_print_nul, cm_get_pid_i, set_ro, nullptr, 0 },
+    { "pid4","pid4d",_fip, 5, tx_print_nul, cm_get_pid_d, set_ro, nullptr, 0 },
+#endif
+#if (HEATERS >= 5)
+    { "pid5","pid5p",_fip, 3, tx_print_nul, cm_get_pid_p, set_ro, nullptr, 0 },
+    { "pid5","pid5i",_fip, 5, tx_print_nul, cm_get_pid_i, set_ro, nullptr, 0 },
+    { "pid5","pid5d",_fip, 5, tx_print_nul, cm_get_pid_d, set_ro, nullptr, 0 },
+#endif
+#if (HEATERS >= 6)
+    { "pid6","pid6p",_fip, 3, tx_print_nul, cm_get_pid_p, set_ro, nullptr, 0 },
+    { "pid6","pid6i",_fip, 5, tx_print_nul, cm_get_pid_i, set_ro, nullptr, 0 },
+    { "pid6","pid6d",_fip, 5, tx_print_nul, cm_get_pid_d, set_ro, nullptr, 0 },
+#endif
 
     // temperature configs - heater set values (read-write)
     // NOTICE: If you change these heater group keys, you MUST change the get/set functions too!
@@ -870,6 +939,9 @@ const cfgItem_t cfgArray[] = {
     { "he1","he1i", _fip, 5, tx_print_nul, cm_get_heater_i,        cm_set_heater_i,        nullptr, H1_DEFAULT_I },
     { "he1","he1d", _fip, 5, tx_print_nul, cm_get_heater_d,        cm_set_heater_d,        nullptr, H1_DEFAULT_D },
     { "he1","he1f", _fi,  5, tx_print_nul, cm_get_heater_f,        cm_set_heater_f,        nullptr, H1_DEFAULT_F },
+    { "he1","he1kf",_fip, 3, tx_print_nul, cm_get_heater_fan_ff,   cm_set_heater_fan_ff,   nullptr, H1_DEFAULT_FAN_FF },
+    { "he1","he1ke",_fip, 4, tx_print_nul, cm_get_heater_extrusion_ff, cm_set_heater_extrusion_ff, nullptr, H1_DEFAULT_EXTRUSION_FF },
+    { "he1","he1au",_i0,  0, tx_print_nul, cm_get_heater_autotune, cm_set_heater_autotune, nullptr, 0 },
     { "he1","he1st",_fi,  1, tx_print_nul, cm_get_set_temperature, cm_set_set_temperature, nullptr, 0 },
     { "he1","he1t", _fi,  1, tx_print_nul, cm_get_temperature,     set_ro,                 nullptr, 0 },
     { "he1","he1op",_fi,  3, tx_print_nul, cm_get_heater_output,   set_ro,                 nullptr, 0 },
@@ -887,11 +959,14 @@ const cfgItem_t cfgArray[] = {
     { "he2","he2i", _fip, 5, tx_print_nul, cm_get_heater_i,        cm_set_heater_i,        nullptr, H2_DEFAULT_I },
     { "he2","he2d", _fip, 5, tx_print_nul, cm_get_heater_d,        cm_set_heater_d,        nullptr, H2_DEFAULT_D },
     { "he2","he2f", _fi,  5, tx_print_nul, cm_get_heater_f,        cm_set_heater_f,        nullptr, H2_DEFAULT_F },
+    { "he2","he2kf",_fip, 3, tx_print_nul, cm_get_heater_fan_ff,   cm_set_heater_fan_ff,   nullptr, H2_DEFAULT_FAN_FF },
+    { "he2","he2ke",_fip, 4, tx_print_nul, cm_get_heater_extrusion_ff, cm_set_heater_extrusion_ff, nullptr, H2_DEFAULT_EXTRUSION_FF },
+    { "he2","he2au",_i0,  0, tx_print_nul, cm_get_heater_autotune, cm_set_heater_autotune, nullptr, 0 },
     { "he2","he2st",_fi,  0, tx_print_nul, cm_get_set_temperature, cm_set_set_temperature, nullptr, 0 },
     { "he2","he2t", _fi,  1, tx_print_nul, cm_get_temperature,     set_ro,                 nullptr, 0 },
     { "he2","he2op",_fi,  3, tx_print_nul, cm_get_heater_output,   set_ro,                 nullptr, 0 },
     { "he2","he2tr",_fi,  3, tx_print_nul, cm_get_thermistor_resistance, set_ro,           nullptr, 0 },
-    { "he1","he1tv",_f0,  6, tx_print_nul, cm_get_thermistor_voltage, set_ro,              nullptr, 0 },
+    { "he2","he2tv",_f0,  6, tx_print_nul, cm_get_thermistor_voltage, set_ro,              nullptr, 0 },
     { "he2","he2an",_fi,  0, tx_print_nul, cm_get_heater_adc,      set_ro,                 nullptr, 0 },
     { "he2","he2fp",_fi,  1, tx_print_nul, cm_get_fan_power,       cm_set_fan_power,       nullptr, 0 },
     { "he2","he2fm",_fi,  1, tx_print_nul, cm_get_fan_min_power,   cm_set_fan_min_power,   nullptr, 0 },
@@ -904,17 +979,71 @@ const cfgItem_t cfgArray[] = {
     { "he3","he3i", _fip, 5, tx_print_nul, cm_get_heater_i,        cm_set_heater_i,        nullptr, H3_DEFAULT_I },
     { "he3","he3d", _fip, 5, tx_print_nul, cm_get_heater_d,        cm_set_heater_d,        nullptr, H3_DEFAULT_D },
     { "he3","he3f", _fi,  5, tx_print_nul, cm_get_heater_f,        cm_set_heater_f,        nullptr, H3_DEFAULT_F },
+    { "he3","he3kf",_fip, 3, tx_print_nul, cm_get_heater_fan_ff,   cm_set_heater_fan_ff,   nullptr, H3_DEFAULT_FAN_FF },
+    { "he3","he3ke",_fip, 4, tx_print_nul, cm_get_heater_extrusion_ff, cm_set_heater_extrusion_ff, nullptr, H3_DEFAULT_EXTRUSION_FF },
+    { "he3","he3au",_i0,  0, tx_print_nul, cm_get_heater_autotune, cm_set_heater_autotune, nullptr, 0 },
     { "he3","he3st",_fi,  0, tx_print_nul, cm_get_set_temperature, cm_set_set_temperature, nullptr, 0 },
     { "he3","he3t", _fi,  1, tx_print_nul, cm_get_temperature,     set_ro,                 nullptr, 0 },
     { "he3","he3op",_fi,  3, tx_print_nul, cm_get_heater_output,   set_ro,                 nullptr, 0 },
     { "he3","he3tr",_fi,  3, tx_print_nul, cm_get_thermistor_resistance, set_ro,           nullptr, 0 },
-    { "he1","he1tv",_f0,  6, tx_print_nul, cm_get_thermistor_voltage, set_ro,              nullptr, 0 },
+    { "he3","he3tv",_f0,  6, tx_print_nul, cm_get_thermistor_voltage, set_ro,              nullptr, 0 },
     { "he3","he3an",_fi,  0, tx_print_nul, cm_get_heater_adc,      set_ro,                 nullptr, 0 },
     { "he3","he3fp",_fi,  1, tx_print_nul, cm_get_fan_power,       cm_set_fan_power,       nullptr, 0 },
     { "he3","he3fm",_fi,  1, tx_print_nul, cm_get_fan_min_power,   cm_set_fan_min_power,   nullptr, 0 },
     { "he3","he3fl",_fi,  1, tx_print_nul, cm_get_fan_low_temp,    cm_set_fan_low_temp,    nullptr, 0 },
     { "he3","he3fh",_fi,  1, tx_print_nul, cm_get_fan_high_temp,   cm_set_fan_high_temp,   nullptr, 0 },
 
+#if (HEATERS >= 4)
+    { "he4","he4e", _iip, 0, tx_print_nul, cm_get_heater_enable,   cm_set_heater_enable,   nullptr, H4_DEFAULT_ENABLE },
+    { "he4","he4at",_b0,  0, tx_print_nul, cm_get_at_temperature,  set_ro,                 nullptr, 0 },
+    { "he4","he4p", _fip, 3, tx_print_nul, cm_get_heater_p,        cm_set_heater_p,        nullptr, H4_DEFAULT_P },
+    { "he4","he4i", _fip, 5, tx_print_nul, cm_get_heater_i,        cm_set_heater_i,        nullptr, H4_DEFAULT_I },
+    { "he4","he4d", _fip, 5, tx_print_nul, cm_get_heater_d,        cm_set_heater_d,        nullptr, H4_DEFAULT_D },
+    { "he4","he4f", _fi,  5, tx_print_nul, cm_get_heater_f,        cm_set_heater_f,        nullptr, H4_DEFAULT_F },
+    { "he4","he4kf",_fip, 3, tx_print_nul, cm_get_heater_fan_ff,   cm_set_heater_fan_ff,   nullptr, H4_DEFAULT_FAN_FF },
+    { "he4","he4au",_i0,  0, tx_print_nul, cm_get_heater_autotune, cm_set_heater_autotune, nullptr, 0 },
+    { "he4","he4st",_fi,  0, tx_print_nul, cm_get_set_temperature, cm_set_set_temperature, nullptr, 0 },
+    { "he4","he4t", _fi,  1, tx_print_nul, cm_get_temperature,     set_ro,                 nullptr, 0 },
+    { "he4","he4op",_fi,  3, tx_print_nul, cm_get_heater_output,   set_ro,                 nullptr, 0 },
+    { "he4","he4tr",_fi,  3, tx_print_nul, cm_get_thermistor_resistance, set_ro,           nullptr, 0 },
+    { "he4","he4tv",_f0,  6, tx_print_nul, cm_get_thermistor_voltage, set_ro,              nullptr, 0 },
+    { "he4","he4an",_fi,  0, tx_print_nul, cm_get_heater_adc,      set_ro,                 nullptr, 0 },
+#endif
+
+#if (HEATERS >= 5)
+    { "he5","he5e", _iip, 0, tx_print_nul, cm_get_heater_enable,   cm_set_heater_enable,   nullptr, H5_DEFAULT_ENABLE },
+    { "he5","he5at",_b0,  0, tx_print_nul, cm_get_at_temperature,  set_ro,                 nullptr, 0 },
+    { "he5","he5p", _fip, 3, tx_print_nul, cm_get_heater_p,        cm_set_heater_p,        nullptr, H5_DEFAULT_P },
+    { "he5","he5i", _fip, 5, tx_print_nul, cm_get_heater_i,        cm_set_heater_i,        nullptr, H5_DEFAULT_I },
+    { "he5","he5d", _fip, 5, tx_print_nul, cm_get_heater_d,        cm_set_heater_d,        nullptr, H5_DEFAULT_D },
+    { "he5","he5f", _fi,  5, tx_print_nul, cm_get_heater_f,        cm_set_heater_f,        nullptr, H5_DEFAULT_F },
+    { "he5","he5kf",_fip, 3, tx_print_nul, cm_get_heater_fan_ff,   cm_set_heater_fan_ff,   nullptr, H5_DEFAULT_FAN_FF },
+    { "he5","he5au",_i0,  0, tx_print_nul, cm_get_heater_autotune, cm_set_heater_autotune, nullptr, 0 },
+    { "he5","he5st",_fi,  0, tx_print_nul, cm_get_set_temperature, cm_set_set_temperature, nullptr, 0 },
+    { "he5","he5t", _fi,  1, tx_print_nul, cm_get_temperature,     set_ro,                 nullptr, 0 },
+    { "he5","he5op",_fi,  3, tx_print_nul, cm_get_heater_output,   set_ro,                 nullptr, 0 },
+    { "he5","he5tr",_fi,  3, tx_print_nul, cm_get_thermistor_resistance, set_ro,           nullptr, 0 },
+    { "he5","he5tv",_f0,  6, tx_print_nul, cm_get_thermistor_voltage, set_ro,              nullptr, 0 },
+    { "he5","he5an",_fi,  0, tx_print_nul, cm_get_heater_adc,      set_ro,                 nullptr, 0 },
+#endif
+
+#if (HEATERS >= 6)
+    { "he6","he6e", _iip, 0, tx_print_nul, cm_get_heater_enable,   cm_set_heater_enable,   nullptr, H6_DEFAULT_ENABLE },
+    { "he6","he6at",_b0,  0, tx_print_nul, cm_get_at_temperature,  set_ro,                 nullptr, 0 },
+    { "he6","he6p", _fip, 3, tx_print_nul, cm_get_heater_p,        cm_set_heater_p,        nullptr, H6_DEFAULT_P },
+    { "he6","he6i", _fip, 5, tx_print_nul, cm_get_heater_i,        cm_set_heater_i,        nullptr, H6_DEFAULT_I },
+    { "he6","he6d", _fip, 5, tx_print_nul, cm_get_heater_d,        cm_set_heater_d,        nullptr, H6_DEFAULT_D },
+    { "he6","he6f", _fi,  5, tx_print_nul, cm_get_heater_f,        cm_set_heater_f,        nullptr, H6_DEFAULT_F },
+    { "he6","he6kf",_fip, 3, tx_print_nul, cm_get_heater_fan_ff,   cm_set_heater_fan_ff,   nullptr, H6_DEFAULT_FAN_FF },
+    { "he6","he6au",_i0,  0, tx_print_nul, cm_get_heater_autotune, cm_set_heater_autotune, nullptr, 0 },
+    { "he6","he6st",_fi,  0, tx_print_nul, cm_get_set_temperature, cm_set_set_temperature, nullptr, 0 },
+    { "he6","he6t", _fi,  1, tx_print_nul, cm_get_temperature,     set_ro,                 nullptr, 0 },
+    { "he6","he6op",_fi,  3, tx_print_nul, cm_get_heater_output,   set_ro,                 nullptr, 0 },
+    { "he6","he6tr",_fi,  3, tx_print_nul, cm_get_thermistor_resistance, set_ro,           nullptr, 0 },
+    { "he6","he6tv",_f0,  6, tx_print_nul, cm_get_thermistor_voltage, set_ro,              nullptr, 0 },
+    { "he6","he6an",_fi,  0, tx_print_nul, cm_get_heater_adc,      set_ro,                 nullptr, 0 },
+#endif
+
     // Coordinate system offsets (G54-G59 and G92)
     { "g54","g54x",_fipc, 5, cm_print_cofs, cm_get_coord, cm_set_coord, nullptr, G54_X_OFFSET },
     { "g54","g54y",_fipc, 5, cm_print_cofs, cm_get_coord, cm_set_coord, nullptr, G54_Y_OFFSET },
@@ -1024,8 +1153,90 @@ const cfgItem_t cfgArray[] = {
     { "fxa","fxa4x",_fipc, 3, tx_print_nul, get_flt, set_flt, &cfg.fx_coords_a[3][0], 0 },
     { "fxa","fxa4y",_fipc, 3, tx_print_nul, get_flt, set_flt, &cfg.fx_coords_a[3][1], 0 },
 
+    // height map (grid probing and Z compensation - see plan_mesh.cpp)
+    { "msh","mshe", _bip,  0, mp_print_mshe,  mp_get_mshe, mp_set_mshe, nullptr, MESH_ENABLE },
+    { "msh","mshx", _fipc, 3, mp_print_mshx,  mp_get_msho, mp_set_msho, nullptr, MESH_ORIGIN_X },
+    { "msh","mshy", _fipc, 3, mp_print_mshy,  mp_get_msho, mp_set_msho, nullptr, MESH_ORIGIN_Y },
+    { "msh","mshdx",_fipc, 3, mp_print_mshdx, mp_get_mshd, mp_set_mshd, nullptr, MESH_SPACING_X },
+    { "msh","mshdy",_fipc, 3, mp_print_mshdy, mp_get_mshd, mp_set_mshd, nullptr, MESH_SPACING_Y },
+    { "msh","mshc", _iip,  0, mp_print_mshc,  mp_get_mshc, mp_set_mshc, nullptr, MESH_COLUMNS },
+    { "msh","mshr", _iip,  0, mp_print_mshr,  mp_get_mshr, mp_set_mshr, nullptr, MESH_ROWS },
+
+    // height map points - mhRC is row R (Y), column C (X), in mm relative to the first point
+    { "mh0","mh00",_fip, 3, mp_print_mh, mp_get_mh, mp_set_mh, nullptr, 0 },
+    { "mh0","mh01",_fip, 3, mp_print_mh, mp_get_mh, mp_set_mh, nullptr, 0 },
+    { "mh0","mh02",_fip, 3, mp_print_mh, mp_get_mh, mp_set_mh, nullptr, 0 },
+    { "mh0","mh03",_fip, 3, mp_print_mh, mp_get_mh, mp_set_mh, nullptr, 0 },
+    { "mh0","mh04",_fip, 3, mp_print_mh, mp_get_mh, mp_set_mh, nullptr, 0 },
+    { "mh0","mh05",_fip, 3, mp_print_mh, mp_get_mh, mp_set_mh, nullptr, 0 },
+    { "mh0","mh06",_fip, 3, mp_print_mh, mp_get_mh, mp_set_mh, nullptr, 0 },
+    { "mh0","mh07",_fip, 3, mp_print_mh, mp_get_mh, mp_set_mh, nullptr, 0 },
+
+    { "mh1","mh10",_fip, 3, mp_print_mh, mp_get_mh, mp_set_mh, nullptr, 0 },
+    { "mh1","mh11",_fip, 3, mp_print_mh, mp_get_mh, mp_set_mh, nullptr, 0 },
+    { "mh1","mh12",_fip, 3, mp_print_mh, mp_get_mh, mp_set_mh, nullptr, 0 },
+    { "mh1","mh13",_fip, 3, mp_print_mh, mp_get_mh, mp_set_mh, nullptr, 0 },
+    { "mh1","mh14",_fip, 3, mp_print_mh, mp_get_mh, mp_set_mh, nullptr, 0 },
+    { "mh1","mh15",_fip, 3, mp_print_mh, mp_get_mh, mp_set_mh, nullptr, 0 },
+    { "mh1","mh16",_fip, 3, mp_print_mh, mp_get_mh, mp_set_mh, nullptr, 0 },
+    { "mh1","mh17",_fip, 3, mp_print_mh, mp_get_mh, mp_set_mh, nullptr, 0 },
+
+    { "mh2","mh20",_fip, 3, mp_print_mh, mp_get_mh, mp_set_mh, nullptr, 0 },
+    { "mh2","mh21",_fip, 3, mp_print_mh, mp_get_mh, mp_set_mh, nullptr, 0 },
+    { "mh2","mh22",_fip, 3, mp_print_mh, mp_get_mh, mp_set_mh, nullptr, 0 },
+    { "mh2","mh23",_fip, 3, mp_print_mh, mp_get_mh, mp_set_mh, nullptr, 0 },
+    { "mh2","mh24",_fip, 3, mp_print_mh, mp_get_mh, mp_set_mh, nullptr, 0 },
+    { "mh2","mh25",_fip, 3, mp_print_mh, mp_get_mh, mp_set_mh, nullptr, 0 },
+    { "mh2","mh26",_fip, 3, mp_print_mh, mp_get_mh, mp_set_mh, nullptr, 0 },
+    { "mh2","mh27",_fip, 3, mp_print_mh, mp_get_mh, mp_set_mh, nullptr, 0 },
+
+    { "mh3","mh30",_fip, 3, mp_print_mh, mp_get_mh, mp_set_mh, nullptr, 0 },
+    { "mh3","mh31",_fip, 3, mp_print_mh, mp_get_mh, mp_set_mh, nullptr, 0 },
+    { "mh3","mh32",_fip, 3, mp_print_mh, mp_get_mh, mp_set_mh, nullptr, 0 },
+    { "mh3","mh33",_fip, 3, mp_print_mh, mp_get_mh, mp_set_mh, nullptr, 0 },
+    { "mh3","mh34",_fip, 3, mp_print_mh, mp_get_mh, mp_set_mh, nullptr, 0 },
+    { "mh3","mh35",_fip, 3, mp_print_mh, mp_get_mh, mp_set_mh, nullptr, 0 },
+    { "mh3","mh36",_fip, 3, mp_print_mh, mp_get_mh, mp_set_mh, nullptr, 0 },
+    { "mh3","mh37",_fip, 3, mp_print_mh, mp_get_mh, mp_set_mh, nullptr, 0 },
+
+    { "mh4","mh40",_fip, 3, mp_print_mh, mp_get_mh, mp_set_mh, nullptr, 0 },
+    { "mh4","mh41",_fip, 3, mp_print_mh, mp_get_mh, mp_set_mh, nullptr, 0 },
+    { "mh4","mh42",_fip, 3, mp_print_mh, mp_get_mh, mp_set_mh, nullptr, 0 },
+    { "mh4","mh43",_fip, 3, mp_print_mh, mp_get_mh, mp_set_mh, nullptr, 0 },
+    { "mh4","mh44",_fip, 3, mp_print_mh, mp_get_mh, mp_set_mh, nullptr, 0 },
+    { "mh4","mh45",_fip, 3, mp_print_mh, mp_get_mh, mp_set_mh, nullptr, 0 },
+    { "mh4","mh46",_fip, 3, mp_print_mh, mp_get_mh, mp_set_mh, nullptr, 0 },
+    { "mh4","mh47",_fip, 3, mp_print_mh, mp_get_mh, mp_set_mh, nullptr, 0 },
+
+    { "mh5","mh50",_fip, 3, mp_print_mh, mp_get_mh, mp_set_mh, nullptr, 0 },
+    { "mh5","mh51",_fip, 3, mp_print_mh, mp_get_mh, mp_set_mh, nullptr, 0 },
+    { "mh5","mh52",_fip, 3, mp_print_mh, mp_get_mh, mp_set_mh, nullptr, 0 },
+    { "mh5","mh53",_fip, 3, mp_print_mh, mp_get_mh, mp_set_mh, nullptr, 0 },
+    { "mh5","mh54",_fip, 3, mp_print_mh, mp_get_mh, mp_set_mh, nullptr, 0 },
+    { "mh5","mh55",_fip, 3, mp_print_mh, mp_get_mh, mp_set_mh, nullptr, 0 },
+    { "mh5","mh56",_fip, 3, mp_print_mh, mp_get_mh, mp_set_mh, nullptr, 0 },
+    { "mh5","mh57",_fip, 3, mp_print_mh, mp_get_mh, mp_set_mh, nullptr, 0 },
+
+    { "mh6","mh60",_fip, 3, mp_print_mh, mp_get_mh, mp_set_mh, nullptr, 0 },
+    { "mh6","mh61",_fip, 3, mp_print_mh, mp_get_mh, mp_set_mh, nullptr, 0 },
+    { "mh6","mh62",_fip, 3, mp_print_mh, mp_get_mh, mp_set_mh, nullptr, 0 },
+    { "mh6","mh63",_fip, 3, mp_print_mh, mp_get_mh, mp_set_mh, nullptr, 0 },
+    { "mh6","mh64",_fip, 3, mp_print_mh, mp_get_mh, mp_set_mh, nullptr, 0 },
+    { "mh6","mh65",_fip, 3, mp_print_mh, mp_get_mh, mp_set_mh, nullptr, 0 },
+    { "mh6","mh66",_fip, 3, mp_print_mh, mp_get_mh, mp_set_mh, nullptr, 0 },
+    { "mh6","mh67",_fip, 3, mp_print_mh, mp_get_mh, mp_set_mh, nullptr, 0 },
+
+    { "mh7","mh70",_fip, 3, mp_print_mh, mp_get_mh, mp_set_mh, nullptr, 0 },
+    { "mh7","mh71",_fip, 3, mp_print_mh, mp_get_mh, mp_set_mh, nullptr, 0 },
+    { "mh7","mh72",_fip, 3, mp_print_mh, mp_get_mh, mp_set_mh, nullptr, 0 },
+    { "mh7","mh73",_fip, 3, mp_print_mh, mp_get_mh, mp_set_mh, nullptr, 0 },
+    { "mh7","mh74",_fip, 3, mp_print_mh, mp_get_mh, mp_set_mh, nullptr, 0 },
+    { "mh7","mh75",_fip, 3, mp_print_mh, mp_get_mh, mp_set_mh, nullptr, 0 },
+    { "mh7","mh76",_fip, 3, mp_print_mh, mp_get_mh, mp_set_mh, nullptr, 0 },
+    { "mh7","mh77",_fip, 3, mp_print_mh, mp_get_mh, mp_set_mh, nullptr, 0 },
+
     // Spindle functions
-    { "sp","spmo", _i0,  0, sp_print_spmo, get_nul,     set_nul,     nullptr, 0 }, // keeping this key around, but it returns null and does nothing
+    { "sp","spmo", _iip, 0, sp_print_spmo, sp_get_spmo, sp_set_spmo, nullptr, SPINDLE_MODE },
     { "sp","spph", _bip, 0, sp_print_spph, sp_get_spph, sp_set_spph, nullptr, SPINDLE_PAUSE_ON_HOLD },
     { "sp","spde", _fip, 2, sp_print_spde, sp_get_spde, sp_set_spde, nullptr, SPINDLE_SPINUP_DELAY },
     { "sp","spsn", _fip, 2, sp_print_spsn, sp_get_spsn, sp_set_spsn, nullptr, SPINDLE_SPEED_MIN},
@@ -1050,6 +1261,8 @@ const cfgItem_t cfgArray[] = {
     { "sys","zl",  _fipnc,3, cm_print_zl,  cm_get_zl,  cm_set_zl,  nullptr, FEEDHOLD_Z_LIFT },
     { "sys","sl",  _bipn, 0, cm_print_sl,  cm_get_sl,  cm_set_sl,  nullptr, SOFT_LIMIT_ENABLE },
     { "sys","lim", _bipn, 0, cm_print_lim, cm_get_lim, cm_set_lim, nullptr, HARD_LIMIT_ENABLE },
+    { "sys","hsim",_bipn, 0, cm_print_hsim,cm_get_hsim,cm_set_hsim,nullptr, HOMING_SIMULTANEOUS },
+    { "sys","jvt", _fipn, 0, cm_print_jvt, cm_get_jvt, cm_set_jvt, nullptr, JOGGING_KEEPALIVE },
     { "sys","saf", _bipn, 0, cm_print_saf, cm_get_saf, cm_set_saf, nullptr, SAFETY_INTERLOCK_ENABLE },
     { "sys","m48", _bin, 0, cm_print_m48,  cm_get_m48, cm_get_m48, nullptr, 1 },   // M48/M49 feedrate & spindle override enable
     { "sys","froe",_bin, 0, cm_print_froe, cm_get_froe,cm_get_froe,nullptr, FEED_OVERRIDE_ENABLE},
@@ -1061,6 +1274,7 @@ const cfgItem_t cfgArray[] = {
     { "",   "md",  _f0,   0, st_print_md,  get_nul,    st_set_md,  nullptr, 0 },    // SET to disable motors
 
     // kinematics controls
+    { "sys","kn",  _iipn, 0, kn_print_kn,  kn_get_kn,  kn_set_kn,  nullptr, KINEMATICS },
 #if KINEMATICS==KINE_FOUR_CABLE
     { "sys","knfc", _f0, 4, tx_print_nul, kn_get_force,    kn_set_force,    nullptr,       0 },
     { "sys","knan", _f0, 0, tx_print_nul, kn_get_anchored, kn_set_anchored, nullptr,       0 },
@@ -1694,7 +1908,7 @@ const cfgItem_t cfgArray[] = {
     { "","6",  _f0, 0, tx_print_nul, get_grp, set_grp, nullptr, 0 },
 #endif
 
-#define DIGITAL_IN_GROUPS D_IN_CHANNELS
+#define DIGITAL_IN_GROUPS (D_IN_CHANNELS+1)  // "in" + di1..diN
     { "","in",  _f0, 0, tx_print_nul, get_grp, set_grp, nullptr, 0 },   // input state
 #if (D_IN_CHANNELS >= 1)
     { "","di1", _f0, 0, tx_print_nul, get_grp, set_grp, nullptr, 0 },   // input configs
@@ -1805,7 +2019,7 @@ const cfgItem_t cfgArray[] = {
     { "","tt32",_f0, 0, tx_print_nul, get_grp, set_grp, nullptr, 0 },   // tt offsets
 #endif
 
-#define MACHINE_STATE_GROUPS 9
+#define MACHINE_STATE_GROUPS 10
     { "","mpo",_f0, 0, tx_print_nul, get_grp, set_grp, nullptr, 0 },    // machine position group
     { "","pos",_f0, 0, tx_print_nul, get_grp, set_grp, nullptr, 0 },    // work position group
     { "","ofs",_f0, 0, tx_print_nul, get_grp, set_grp, nullptr, 0 },    // work offset group
@@ -1813,16 +2027,46 @@ const cfgItem_t cfgArray[] = {
     { "","prb",_f0, 0, tx_print_nul, get_grp, set_grp, nullptr, 0 },    // probing state group
     { "","pwr",_f0, 0, tx_print_nul, get_grp, set_grp, nullptr, 0 },    // motor power enagled group
     { "","jog",_f0, 0, tx_print_nul, get_grp, set_grp, nullptr, 0 },    // axis jogging state group
+    { "","jgv",_f0, 0, tx_print_nul, get_grp, set_grp, nullptr, 0 },    // velocity jogging group
     { "","jid",_f0, 0, tx_print_nul, get_grp, set_grp, nullptr, 0 },    // job ID group
     { "","fxa",_f0, 0, tx_print_nul, get_grp, set_grp, nullptr, 0 },    // fixturing group a
 
-#define TEMPERATURE_GROUPS 6
+#define MESH_GROUPS (MESH_ROWS_MAX+1)
+    { "","msh", _f0, 0, tx_print_nul, get_grp, set_grp, nullptr, 0 },   // height map group
+    { "","mh0", _f0, 0, tx_print_nul, get_grp, set_grp, nullptr, 0 },   // height map row 0
+    { "","mh1", _f0, 0, tx_print_nul, get_grp, set_grp, nullptr, 0 },   // height map row 1
+    { "","mh2", _f0, 0, tx_print_nul, get_grp, set_grp, nullptr, 0 },   // height map row 2
+    { "","mh3", _f0, 0, tx_print_nul, get_grp, set_grp, nullptr, 0 },   // height map row 3
+    { "","mh4", _f0, 0, tx_print_nul, get_grp, set_grp, nullptr, 0 },   // height map row 4
+    { "","mh5", _f0, 0, tx_print_nul, get_grp, set_grp, nullptr, 0 },   // height map row 5
+    { "","mh6", _f0, 0, tx_print_nul, get_grp, set_grp, nullptr, 0 },   // height map row 6
+    { "","mh7", _f0, 0, tx_print_nul, get_grp, set_grp, nullptr, 0 },   // height map row 7
+
+#define TEMPERATURE_GROUPS (HEATERS*2)
     { "","he1", _f0, 0, tx_print_nul, get_grp, set_grp, nullptr, 0 },   // heater 1 group
     { "","he2", _f0, 0, tx_print_nul, get_grp, set_grp, nullptr, 0 },   // heater 2 group
     { "","he3", _f0, 0, tx_print_nul, get_grp, set_grp, nullptr, 0 },   // heater 3 group
+#if (HEATERS >= 4)
+    { "","he4", _f0, 0, tx_print_nul, get_grp, set_grp, nullptr, 0 },   // heater 4 group
+#endif
+#if (HEATERS >= 5)
+    { "","he5", _f0, 0, tx_print_nul, get_grp, set_grp, nullptr, 0 },   // heater 5 group
+#endif
+#if (HEATERS >= 6)
+    { "","he6", _f0, 0, tx_print_nul, get_grp, set_grp, nullptr, 0 },   // heater 6 group
+#endif
     { "","pid1",_f0, 0, tx_print_nul, get_grp, set_grp, nullptr, 0 },   // PID 1 group
     { "","pid2",_f0, 0, tx_print_nul, get_grp, set_grp, nullptr, 0 },   // PID 2 group
     { "","pid3",_f0, 0, tx_print_nul, get_grp, set_grp, nullptr, 0 },   // PID 3 group
+#if (HEATERS >= 4)
+    { "","pid4",_f0, 0, tx_print_nul, get_grp, set_grp, nullptr, 0 },   // PID 4 group
+#endif
+#if (HEATERS >= 5)
+    { "","pid5",_f0, 0, tx_print_nul, get_grp, set_grp, nullptr, 0 },   // PID 5 group
+#endif
+#if (HEATERS >= 6)
+    { "","pid6",_f0, 0, tx_print_nul, get_grp, set_grp, nullptr, 0 },   // PID 6 group
+#endif
 
 #ifdef __USER_DATA
 #define USER_DATA_GROUPS 4
@@ -1868,6 +2112,7 @@ const cfgItem_t cfgArray[] = {
                         + COORDINATE_OFFSET_GROUPS \
                         + TOOL_OFFSET_GROUPS \
                         + MACHINE_STATE_GROUPS \
+                        + MESH_GROUPS \
                         + TEMPERATURE_GROUPS \
                         + USER_DATA_GROUPS \
                         + DIAGNOSTIC_GROUPS)
@@ -1884,6 +2129,136 @@ bool nv_index_is_single(index_t index) { return ((index <= NV_INDEX_END_SINGLES)
 bool nv_index_is_group(index_t index) { return (((index >= NV_INDEX_START_GROUPS) && (index < NV_INDEX_START_UBER_GROUPS)) ? true : false);}
 bool nv_index_lt_groups(index_t index) { return ((index <= NV_INDEX_START_GROUPS) ? true : false);}
 
+/***** COMPILE-TIME INDEXES ******************************************************
+ *
+ *  cfgArray stays the declarative spec. The indexes below are generated from it by
+ *  the compiler and live in flash with the table:
+ *
+ *  - token index  - open-addressed hash of the full tokens (linear probing). Replaces
+ *                   the linear scan in nv_get_index(). Duplicate tokens fail the build.
+ *  - group index  - the singles that belong to each group, sorted by group and kept in
+ *                   table order within the group. Replaces the full-table scan in get_grp().
+ *
+ *  The static_asserts also check that the group section lines up with NV_COUNT_GROUPS,
+ *  which nv_index_is_group() and friends depend on.
+ */
+
+#define NV_HASH_SIZE _nv_hash_size(NV_INDEX_MAX + NV_INDEX_MAX/2)   // <= 2/3 load factor
+#define NV_SINGLES_COUNT (NV_INDEX_END_SINGLES + 1)
+
+static constexpr index_t _nv_hash_size(index_t min_size)
+{
+    index_t size = 1;
+    while (size < min_size) { size <<= 1; }
+    return (size);
+}
+
+static constexpr bool _nv_token_eq(const char *a, const char *b)
+{
+    for (uint8_t i=0; i < TOKEN_LEN; i++) {
+        if (a[i] != b[i]) { return (false); }
+        if (a[i] == NUL) { return (true); }
+    }
+    return (true);
+}
+
+struct cfgIndex_t {
+    uint16_t token_slot[NV_HASH_SIZE];                  // cfgArray index, or NO_MATCH if the slot is empty
+    uint16_t group_start[NV_COUNT_GROUPS+1];            // first group_member of each group, +1 for the end
+    uint16_t group_member[NV_SINGLES_COUNT];            // only the first group_start[NV_COUNT_GROUPS] are used
+    index_t duplicate;                                  // first duplicated token, or NO_MATCH
+};
+
+static constexpr index_t _nv_probe(const cfgIndex_t &idx, const char *str)
+{
+    for (index_t h = nv_hash_token(str) & (NV_HASH_SIZE-1); ; h = (h+1) & (NV_HASH_SIZE-1)) {
+        if (idx.token_slot[h] == NO_MATCH) { return (NO_MATCH); }
+        if (_nv_token_eq(cfgArray[idx.token_slot[h]].token, str)) { return (idx.token_slot[h]); }
+    }
+}
+
+static constexpr cfgIndex_t _nv_build_index()
+{
+    cfgIndex_t idx {};
+    idx.duplicate = NO_MATCH;
+
+    for (index_t h=0; h < NV_HASH_SIZE; h++) {
+        idx.token_slot[h] = NO_MATCH;
+    }
+    for (index_t i=0; i < NV_INDEX_MAX; i++) {
+        index_t h = nv_hash_token(cfgArray[i].token) & (NV_HASH_SIZE-1);
+        while (idx.token_slot[h] != NO_MATCH) {
+            if ((idx.duplicate == NO_MATCH) && _nv_token_eq(cfgArray[idx.token_slot[h]].token, cfgArray[i].token)) {
+                idx.duplicate = i;
+            }
+            h = (h+1) & (NV_HASH_SIZE-1);
+        }
+        idx.token_slot[h] = i;
+    }
+
+    // counting sort of the singles by group - the group of a single is the group entry whose token is its group string
+    uint16_t group_of[NV_SINGLES_COUNT] {};
+    for (index_t i=0; i < NV_SINGLES_COUNT; i++) {
+        index_t g = (cfgArray[i].group[0] == NUL) ? NO_MATCH : _nv_probe(idx, cfgArray[i].group);
+        if ((g >= NV_INDEX_START_GROUPS) && (g < NV_INDEX_START_UBER_GROUPS)) {
+            group_of[i] = g - NV_INDEX_START_GROUPS;
+            idx.group_start[group_of[i]+1]++;
+        } else {
+            group_of[i] = NO_MATCH;
+        }
+    }
+    for (index_t g=0; g < NV_COUNT_GROUPS; g++) {
+        idx.group_start[g+1] += idx.group_start[g];
+    }
+    uint16_t next[NV_COUNT_GROUPS] {};
+    for (index_t g=0; g < NV_COUNT_GROUPS; g++) {
+        next[g] = idx.group_start[g];
+    }
+    for (index_t i=0; i < NV_SINGLES_COUNT; i++) {
+        if (group_of[i] != NO_MATCH) {
+            idx.group_member[next[group_of[i]]++] = i;
+        }
+    }
+    return (idx);
+}
+
+static constexpr bool _nv_groups_line_up()
+{
+    if (cfgArray[NV_INDEX_START_GROUPS-1].get == get_grp) { return (false); }   // a group ahead of the count
+    for (index_t i=NV_INDEX_START_GROUPS; i < NV_INDEX_START_UBER_GROUPS; i++) {
+        if (cfgArray[i].get != get_grp) { return (false); }
+    }
+    return (true);
+}
+
+static_assert(NV_INDEX_MAX < NO_MATCH, "cfgArray is too large for the 16 bit indexes");
+static_assert(_nv_groups_line_up(), "group entries in cfgArray do not agree with NV_COUNT_GROUPS");
+
+static constexpr cfgIndex_t cfgIndex = _nv_build_index();
+
+static_assert(cfgIndex.duplicate == NO_MATCH, "duplicate token in cfgArray");
+
+/*
+ * nv_index_lookup()  - return the cfgArray index of a full token (group prefix included), or NO_MATCH
+ * nv_group_members() - return the cfgArray indexes of the members of a group, in table order
+ */
+
+index_t nv_index_lookup(const char *str)
+{
+    return (_nv_probe(cfgIndex, str));
+}
+
+const uint16_t *nv_group_members(index_t index, index_t *count)
+{
+    if (!nv_index_is_group(index)) {
+        *count = 0;
+        return (cfgIndex.group_member);
+    }
+    index_t g = index - NV_INDEX_START_GROUPS;
+    *count = cfgIndex.group_start[g+1] - cfgIndex.group_start[g];
+    return (&cfgIndex.group_member[cfgIndex.group_start[g]]);
+}
+
 /***** APPLICATION SPECIFIC CONFIGS AND EXTENSIONS TO GENERIC FUNCTIONS *****/
 /*
  * convert_incoming_float() - pre-process an incoming floating point number for canonical units
@@ -2167,7 +2542,7 @@ static stat_t _do_outputs(nvObj_t *nv)  // print parameters for all output group
 static stat_t _do_heaters(nvObj_t *nv)  // print parameters for all heater groups
 {
     char group[GROUP_LEN];
-    for (uint8_t i=1; i < 4; i++) {
+    for (uint8_t i=1; i < HEATERS+1; i++) {
         sprintf(group, "he%d", i);
         _do_group(nv, group);
     }
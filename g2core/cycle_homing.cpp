@@ -35,31 +35,40 @@
 #include "planner.h"
 #include "encoder.h"
 #include "kinematics.h"
+#include "stepper.h"
 #include "gpio.h"
 #include "report.h"
 #include "util.h"
 
 /**** Homing singleton structure ****/
 
+struct hmHomingAxis {               // per-axis parameters
+    float search_travel;            // signed distance to travel in search
+    float search_velocity;          // search speed as positive number
+    float latch_backoff;            // max distance to back off switch during latch phase
+    float latch_velocity;           // latch speed as positive number
+    float zero_backoff;             // distance to back off switch before setting zero
+    float setpoint;                 // ultimate setpoint, usually zero, but not always
+};
+
 struct hmHomingSingleton {          // persistent homing runtime variables
                                     // controls for homing cycle
     bool   waiting_for_motion_end;  // true when waiting for motion to complete.
-    int8_t axis;                    // axis currently being homed
+    int8_t axis;                    // axis currently being homed (the last axis of a group)
     int8_t homing_input;            // homing input for current axis
     bool   set_coordinates;         // G28.4 flag. true = set coords to zero at the end of homing cycle
     stat_t (*func)(int8_t axis);    // binding for callback function state machine
 
     bool axis_flags[AXES];          // local storage for axis flags
 
-    // per-axis parameters
-    float direction;                // set to 1 for positive (max), -1 for negative (to min);
-    float search_travel;            // signed distance to travel in search
-    float search_velocity;          // search speed as positive number
-    float latch_backoff;            // max distance to back off switch during latch phase
-    float latch_velocity;           // latch speed as positive number
-    float zero_backoff;             // distance to back off switch before setting zero
-    float max_clear_backoff;        // maximum distance of switch clearing backoffs before erring out
-    float setpoint;                 // ultimate setpoint, usually zero, but not always
+    // group homing - axes homed together with each motor stopped by its own input
+    bool    group;                  // true if homing a group
+    bool    group_axes[AXES];       // axes in the group
+    uint8_t group_motors;           // motors in the group, one bit per motor
+    volatile uint8_t latched_motors;// group motors stopped by their input in this move
+    uint8_t motor_input[MOTORS];    // input that stops each motor in the group
+
+    struct hmHomingAxis a[AXES];    // per-axis parameters
 
     // state saved from gcode model
     cmUnitsMode    saved_units_mode;      // G20,G21 global setting
@@ -74,6 +83,7 @@ static struct hmHomingSingleton hm;
 
 static stat_t _set_homing_func(stat_t (*func)(int8_t axis));
 static stat_t _homing_axis_start(int8_t axis);
+static stat_t _homing_axis_init(int8_t axis);
 static stat_t _homing_axis_clear_init(int8_t axis);
 static stat_t _homing_axis_search(int8_t axis);
 static stat_t _homing_axis_clear(int8_t axis);
@@ -86,6 +96,18 @@ static stat_t _homing_finalize_exit(int8_t axis);
 static int8_t _get_next_axis(int8_t axis);
 static void _homing_axis_move_callback(float* vect, bool* flag);
 
+static stat_t _homing_group_start(int8_t axis);
+static stat_t _homing_group_clear_init(int8_t axis);
+static stat_t _homing_group_search(int8_t axis);
+static stat_t _homing_group_clear(int8_t axis);
+static stat_t _homing_group_latch(int8_t axis);
+static stat_t _homing_group_setpoint_backoff(int8_t axis);
+static stat_t _homing_group_set_position(int8_t axis);
+static stat_t _homing_group_move(int8_t axis, const float travel[], const float velocity[], bool stop_on_inputs);
+static void _homing_group_sync(void);
+static stat_t _homing_group_not_latched(int8_t axis);
+static bool _homing_group_input(const uint8_t input, const inputEdgeFlag edge);
+
 /**** HELPERS ***************************************************************************
  * _set_homing_func() - a convenience for setting the next dispatch vector and exiting
  */
@@ -98,14 +120,22 @@ static stat_t _set_homing_func(stat_t (*func)(int8_t axis)) {
 /*
  * _homing_handler - a gpioDigitalInputHandler to capture pin change events
  *   Will be registered only during homing mode - see gpio.h for more info
+ *
+ *   For sensorless homing the homing input is the motor's STALL_INPUT(), which the driver
+ *   reports stalls on (see stepper.h). Stalls are only detected above the driver's stall
+ *   detection speed (for the TMC2130, faster than TCOOLTHRS and out of stealthChop), so the
+ *   latch velocity has to be set above that as well.
+ *
+ *   When homing a group the inputs stop motors one by one instead - see _homing_group_input()
  */
 gpioDigitalInputHandler _homing_handler {
-    [&](const bool state, const inputEdgeFlag edge, const uint8_t triggering_pin_number) {
+    [](const bool state, const inputEdgeFlag edge, const uint8_t triggering_pin_number) {
         if (cm->cycle_type != CYCLE_HOMING) { return GPIO_NOT_HANDLED; }
+        if (hm.group) { return (_homing_group_input(triggering_pin_number, edge)); }
         if (triggering_pin_number != hm.homing_input) { return GPIO_NOT_HANDLED; }
         if (edge != INPUT_EDGE_LEADING) { return GPIO_NOT_HANDLED; }
 
-        en_take_encoder_snapshot();
+        en_take_encoder_snapshot(din_edge_ticks);
         cm_request_feedhold(FEEDHOLD_TYPE_SKIP, FEEDHOLD_EXIT_RESET_POSITION);
 
         return GPIO_HANDLED; // DO NOT allow others to see this notice (particularly limits)
@@ -137,6 +167,12 @@ gpioDigitalInputHandler _homing_handler {
  *  Homing is always run in the following order - for each enabled axis:
  *    Z,X,Y,A,B,C
  *
+ *  With simultaneous homing enabled ($hsim=1) X and Y are homed together after Z,
+ *  provided they don't share inputs. Each axis stops on its own switch, and the
+ *  longer search doesn't wait for the shorter. An axis whose motors have their own
+ *  homing inputs ($1hi...) is also homed this way, each motor stopping on its own
+ *  switch - this squares a dual motor gantry. See "Group homing" below.
+ *
  *  After initialization the following sequence is run for each axis to be homed:
  *
  *  0. Limits are automatically disabled. Shutdown and safety interlocks are not.
@@ -271,6 +307,31 @@ static stat_t _homing_axis_start(int8_t axis) {
             return (_homing_error_exit(-2, STAT_HOMING_ERROR_BAD_OR_NO_AXIS));
         }
     }
+    ritorno(_homing_axis_init(axis));
+    hm.axis = axis;                                             // persist the axis
+
+    // home the axis with others, or motor by motor, if it's set up for that
+    stat_t status = _homing_group_start(axis);
+    if (status != STAT_NOOP) {
+        return (status);
+    }
+
+    // Nothing to do about direction now that direction is explicit
+    // However, here's a good place to stash the homing_switch:
+    hm.homing_input = cm->a[axis].homing_input;
+    if (din_handlers[INPUT_ACTION_INTERNAL].registerHandler(&_homing_handler) != STAT_OK) {
+        return (_homing_error_exit(axis, STAT_HOMING_CYCLE_FAILED));
+    }
+
+    // if homing is disabled for the axis then skip to the next axis
+    return (_set_homing_func(_homing_axis_clear_init));         // perform an initial clear
+}
+
+/***********************************************************************************
+ * _homing_axis_init() - check the axis' settings and set up its parameters
+ */
+static stat_t _homing_axis_init(int8_t axis) {
+
     // clear the homed flag for axis so we'll be able to move w/o triggering soft limits
     cm->homed[axis] = false;
 
@@ -298,36 +359,29 @@ static stat_t _homing_axis_start(int8_t axis) {
         return (_homing_error_exit(axis, STAT_HOMING_ERROR_TRAVEL_MIN_MAX_IDENTICAL));
     }
 
-    // Nothing to do about direction now that direction is explicit
-    // However, here's a good place to stash the homing_switch:
-    hm.homing_input = cm->a[axis].homing_input;
-    din_handlers[INPUT_ACTION_INTERNAL].registerHandler(&_homing_handler);
-
-    hm.axis            = axis;                                  // persist the axis
-    hm.search_velocity = std::abs(cm->a[axis].search_velocity);     // search velocity is always positive
-    hm.latch_velocity  = std::abs(cm->a[axis].latch_velocity);      // latch velocity is always positive
+    struct hmHomingAxis *p = &hm.a[axis];
+    p->search_velocity = std::abs(cm->a[axis].search_velocity);     // search velocity is always positive
+    p->latch_velocity  = std::abs(cm->a[axis].latch_velocity);      // latch velocity is always positive
 
     bool homing_to_max = cm->a[axis].homing_dir;
 
     // setup parameters for positive or negative travel (homing to the max or min switch)
     if (homing_to_max) {
-        hm.search_travel = travel_distance;                     // search travels in positive direction
-        hm.latch_backoff = std::abs(cm->a[axis].latch_backoff);     // latch travels in positive direction
-        hm.zero_backoff  = -std::max(0.0f, cm->a[axis].zero_backoff);// zero backoff is negative direction (or zero)
+        p->search_travel = travel_distance;                     // search travels in positive direction
+        p->latch_backoff = std::abs(cm->a[axis].latch_backoff);     // latch travels in positive direction
+        p->zero_backoff  = -std::max(0.0f, cm->a[axis].zero_backoff);// zero backoff is negative direction (or zero)
                                                                 // will set the maximum position
                                                                 //     (plus any negative backoff)
-        hm.setpoint = cm->a[axis].travel_max + (std::max(0.0f, -cm->a[axis].zero_backoff));
+        p->setpoint = cm->a[axis].travel_max + (std::max(0.0f, -cm->a[axis].zero_backoff));
     } else {
-        hm.search_travel = -travel_distance;                    // search travels in negative direction
-        hm.latch_backoff = -std::abs(cm->a[axis].latch_backoff);    // latch travels in negative direction
-        hm.zero_backoff  = std::max(0.0f, cm->a[axis].zero_backoff); // zero backoff is positive direction (or zero)
+        p->search_travel = -travel_distance;                    // search travels in negative direction
+        p->latch_backoff = -std::abs(cm->a[axis].latch_backoff);    // latch travels in negative direction
+        p->zero_backoff  = std::max(0.0f, cm->a[axis].zero_backoff); // zero backoff is positive direction (or zero)
                                                                 // will set the minimum position
                                                                 //     (minus any negative backoff)
-        hm.setpoint = cm->a[axis].travel_min + (std::max(0.0f, -cm->a[axis].zero_backoff));
+        p->setpoint = cm->a[axis].travel_min + (std::max(0.0f, -cm->a[axis].zero_backoff));
     }
-
-    // if homing is disabled for the axis then skip to the next axis
-    return (_set_homing_func(_homing_axis_clear_init));         // perform an initial clear
+    return (STAT_OK);
 }
 
 /***********************************************************************************
@@ -347,7 +401,7 @@ static stat_t _homing_axis_clear_init(int8_t axis)  // first clear move
                     axis, STAT_HOMING_ERROR_MUST_CLEAR_SWITCHES_BEFORE_HOMING));  // axis cannot be homed
             }
         }
-        _homing_axis_move(axis, -hm.latch_backoff, hm.search_velocity);  // otherwise back off the switch
+        _homing_axis_move(axis, -hm.a[axis].latch_backoff, hm.a[axis].search_velocity);  // otherwise back off the switch
     }
     return (_set_homing_func(_homing_axis_search));  // start the search
 }
@@ -357,7 +411,7 @@ static stat_t _homing_axis_clear_init(int8_t axis)  // first clear move
  */
 static stat_t _homing_axis_search(int8_t axis)  // drive to switch
 {
-    _homing_axis_move(axis, hm.search_travel, hm.search_velocity);
+    _homing_axis_move(axis, hm.a[axis].search_travel, hm.a[axis].search_velocity);
     return (_set_homing_func(_homing_axis_clear));
 }
 
@@ -366,7 +420,7 @@ static stat_t _homing_axis_search(int8_t axis)  // drive to switch
  */
 static stat_t _homing_axis_clear(int8_t axis)  // drive away from switch at search speed
 {
-    _homing_axis_move(axis, -hm.latch_backoff, hm.search_velocity);
+    _homing_axis_move(axis, -hm.a[axis].latch_backoff, hm.a[axis].search_velocity);
     return (_set_homing_func(_homing_axis_latch));
 }
 
@@ -375,7 +429,7 @@ static stat_t _homing_axis_clear(int8_t axis)  // drive away from switch at sear
  */
 static stat_t _homing_axis_latch(int8_t axis)  // drive to switch at low speed
 {
-    _homing_axis_move(axis, hm.latch_backoff, hm.latch_velocity);
+    _homing_axis_move(axis, hm.a[axis].latch_backoff, hm.a[axis].latch_velocity);
     return (_set_homing_func(_homing_axis_setpoint_backoff));
 }
 
@@ -384,7 +438,7 @@ static stat_t _homing_axis_latch(int8_t axis)  // drive to switch at low speed
  */
 static stat_t _homing_axis_setpoint_backoff(int8_t axis)  //
 {
-    _homing_axis_move(axis, hm.zero_backoff, hm.search_velocity);
+    _homing_axis_move(axis, hm.a[axis].zero_backoff, hm.a[axis].search_velocity);
     return (_set_homing_func(_homing_axis_set_position));
 }
 
@@ -394,13 +448,13 @@ static stat_t _homing_axis_setpoint_backoff(int8_t axis)  //
 static stat_t _homing_axis_set_position(int8_t axis)
 {
     if (hm.set_coordinates) {
-        cm_set_position_by_axis(axis, hm.setpoint);
+        cm_set_position_by_axis(axis, hm.a[axis].setpoint);
         cm->homed[axis] = true;
 
     } else {  // handle G28.4 cycle - set position to the point of switch closure
         float contact_position[AXES];
         kn_forward_kinematics(en_get_encoder_snapshot_vector(), contact_position);
-        _homing_axis_move(axis, contact_position[AXIS_Z], hm.search_velocity);
+        _homing_axis_move(axis, contact_position[AXIS_Z], hm.a[axis].search_velocity);
     }
 
     din_handlers[INPUT_ACTION_INTERNAL].deregisterHandler(&_homing_handler);  // end homing mode
@@ -436,6 +490,340 @@ static stat_t _homing_axis_move(int8_t axis, float target, float velocity) {
 static void _homing_axis_move_callback(float* vect, bool* flag) { hm.waiting_for_motion_end = false; }
 
 
+/***********************************************************************************
+ **** Group homing *****************************************************************
+ ***********************************************************************************/
+/*
+ *  A group is homed with the same clear, search, clear, latch and backoff moves as a
+ *  single axis, but each is one move for all the axes in the group. Axes travel their
+ *  own distances, slowed so they all finish together at no more than their own velocity.
+ *
+ *  During the search and latch each motor is locked (st_lock_motor()) as soon as its input
+ *  trips, and the rest of the move goes on for the motors that haven't got there yet. A
+ *  motor's input is its own homing input ($1hi...) if it has one, otherwise its axis'. Once
+ *  every motor in the group is locked the rest of the move is skipped with a feedhold - if
+ *  any motor's input hasn't tripped by the end of the search or latch the cycle fails.
+ *
+ *  After each move the motors are unlocked and the axis positions are taken from the steps
+ *  the motors actually made (_homing_group_sync()). Motors on the same axis that stopped at
+ *  different points - a racked gantry - take the same position from then on, so the latch
+ *  leaves the gantry square. A motor stops dead on its input, so the search velocity has to
+ *  be one the motors can stop from without losing steps. Lost steps in the search don't
+ *  matter though, as the latch sets the position.
+ *
+ *  A group is:
+ *    - X and Y, if simultaneous homing is enabled, both are being homed and none of X's
+ *      motors has the same input as any of Y's motors. Otherwise they are homed one by one.
+ *    - any other axis that has a motor with its own homing input, by itself
+ *
+ *  Group homing needs Cartesian kinematics, where each motor moves one axis. Under CoreXY
+ *  (or cables) locking one motor moves the others' axes off line, so those machines always
+ *  home one axis at a time.
+ */
+
+/*
+ * _homing_group_start() - set up the group homed from this axis, or return STAT_NOOP if none
+ */
+static stat_t _homing_group_start(int8_t axis)
+{
+    if (kn_get_type() != KINE_CARTESIAN) {
+        return (STAT_NOOP);
+    }
+
+    // the input that stops each motor
+    for (uint8_t motor = MOTOR_1; motor < MOTORS; motor++) {
+        uint8_t motor_axis = st_cfg.mot[motor].motor_map;
+        hm.motor_input[motor] = (motor_axis < AXES) ? cm->a[motor_axis].homing_input : 0;
+        if (st_cfg.mot[motor].homing_input != 0) {
+            hm.motor_input[motor] = st_cfg.mot[motor].homing_input;
+        }
+    }
+
+    // X and Y can't be told apart if they share an input - home them one by one
+    bool simultaneous = (axis == AXIS_X) && cm->homing_simultaneous && hm.axis_flags[AXIS_Y];
+    for (uint8_t x = MOTOR_1; x < MOTORS; x++) {
+        for (uint8_t y = MOTOR_1; y < MOTORS; y++) {
+            if ((st_cfg.mot[x].motor_map == AXIS_X) && (st_cfg.mot[y].motor_map == AXIS_Y) &&
+                (hm.motor_input[x] == hm.motor_input[y])) {
+                simultaneous = false;
+            }
+        }
+    }
+
+    bool own_input = false;
+    hm.group_motors = 0;
+    for (uint8_t a = AXIS_X; a < AXES; a++) {
+        hm.group_axes[a] = (a == axis) || (simultaneous && (a == AXIS_Y));
+    }
+    for (uint8_t motor = MOTOR_1; motor < MOTORS; motor++) {
+        uint8_t motor_axis = st_cfg.mot[motor].motor_map;
+        if ((motor_axis < AXES) && hm.group_axes[motor_axis]) {
+            hm.group_motors |= (1 << motor);
+            own_input |= (st_cfg.mot[motor].homing_input != 0);
+        }
+    }
+    if (!simultaneous && !own_input) {
+        return (STAT_NOOP);
+    }
+    if (simultaneous) {
+        ritorno(_homing_axis_init(AXIS_Y));
+        hm.axis = AXIS_Y;                           // Y is done with X, carry on from Y
+    }
+
+    hm.group = true;
+    if (din_handlers[INPUT_ACTION_INTERNAL].registerHandler(&_homing_handler) != STAT_OK) {
+        return (_homing_error_exit(axis, STAT_HOMING_CYCLE_FAILED));
+    }
+    return (_set_homing_func(_homing_group_clear_init));
+}
+
+/*
+ * _homing_group_input() - stop the motors on an input that has tripped
+ *
+ *  Runs from the input interrupt, through _homing_handler
+ */
+static bool _homing_group_input(const uint8_t input, const inputEdgeFlag edge)
+{
+    uint8_t motors = 0;
+    for (uint8_t motor = MOTOR_1; motor < MOTORS; motor++) {
+        if ((hm.group_motors & (1 << motor)) && (hm.motor_input[motor] == input)) {
+            motors |= (1 << motor);
+        }
+    }
+    if (motors == 0) {
+        return (GPIO_NOT_HANDLED);
+    }
+    if ((edge != INPUT_EDGE_LEADING) || !(motors & ~hm.latched_motors)) {
+        return (GPIO_HANDLED);                      // keep limits from seeing the homing inputs
+    }
+
+    for (uint8_t motor = MOTOR_1; motor < MOTORS; motor++) {
+        if (motors & (1 << motor)) {
+            st_lock_motor(motor);
+        }
+    }
+    hm.latched_motors |= motors;
+    if (hm.latched_motors == hm.group_motors) {     // all there - skip the rest of the move
+        cm_request_feedhold(FEEDHOLD_TYPE_SKIP, FEEDHOLD_EXIT_CYCLE);
+    }
+    return (GPIO_HANDLED);
+}
+
+/*
+ * _homing_group_clear_init() - back the axes off any of the group's switches that are closed
+ *
+ *  Like _homing_axis_clear_init() this relies on the switch not being shared with an axis
+ *  outside the group
+ */
+static stat_t _homing_group_clear_init(int8_t axis)
+{
+    float travel[AXES] = INIT_AXES_ZEROES;
+    float velocity[AXES] = INIT_AXES_ZEROES;
+
+    for (uint8_t motor = MOTOR_1; motor < MOTORS; motor++) {
+        if (!(hm.group_motors & (1 << motor)) || (gpio_read_input(hm.motor_input[motor]) != INPUT_ACTIVE)) {
+            continue;
+        }
+        uint8_t motor_axis = st_cfg.mot[motor].motor_map;
+        for (uint8_t check_axis = AXIS_X; check_axis < AXES; check_axis++) {
+            if (!hm.group_axes[check_axis] && (cm->a[check_axis].homing_input == hm.motor_input[motor])) {
+                return (_homing_error_exit(motor_axis, STAT_HOMING_ERROR_MUST_CLEAR_SWITCHES_BEFORE_HOMING));
+            }
+        }
+        travel[motor_axis] = -hm.a[motor_axis].latch_backoff;
+        velocity[motor_axis] = hm.a[motor_axis].search_velocity;
+    }
+    _homing_group_move(axis, travel, velocity, false);
+    return (_set_homing_func(_homing_group_search));
+}
+
+/*
+ * _homing_group_search() - fast search for the switches, stopping at each
+ */
+static stat_t _homing_group_search(int8_t axis)
+{
+    float travel[AXES] = INIT_AXES_ZEROES;
+    float velocity[AXES] = INIT_AXES_ZEROES;
+
+    _homing_group_sync();
+    for (uint8_t a = AXIS_X; a < AXES; a++) {
+        if (hm.group_axes[a]) {
+            travel[a] = hm.a[a].search_travel;
+            velocity[a] = hm.a[a].search_velocity;
+        }
+    }
+    _homing_group_move(axis, travel, velocity, true);
+    return (_set_homing_func(_homing_group_clear));
+}
+
+/*
+ * _homing_group_clear() - clear off the switches
+ */
+static stat_t _homing_group_clear(int8_t axis)
+{
+    float travel[AXES] = INIT_AXES_ZEROES;
+    float velocity[AXES] = INIT_AXES_ZEROES;
+
+    if (hm.latched_motors != hm.group_motors) {
+        return (_homing_group_not_latched(axis));
+    }
+    _homing_group_sync();
+    for (uint8_t a = AXIS_X; a < AXES; a++) {
+        if (hm.group_axes[a]) {
+            travel[a] = -hm.a[a].latch_backoff;
+            velocity[a] = hm.a[a].search_velocity;
+        }
+    }
+    _homing_group_move(axis, travel, velocity, false);
+    return (_set_homing_func(_homing_group_latch));
+}
+
+/*
+ * _homing_group_latch() - slow drive to the switches, stopping at each
+ */
+static stat_t _homing_group_latch(int8_t axis)
+{
+    float travel[AXES] = INIT_AXES_ZEROES;
+    float velocity[AXES] = INIT_AXES_ZEROES;
+
+    _homing_group_sync();
+    for (uint8_t a = AXIS_X; a < AXES; a++) {
+        if (hm.group_axes[a]) {
+            travel[a] = hm.a[a].latch_backoff;
+            velocity[a] = hm.a[a].latch_velocity;
+        }
+    }
+    _homing_group_move(axis, travel, velocity, true);
+    return (_set_homing_func(_homing_group_setpoint_backoff));
+}
+
+/*
+ * _homing_group_setpoint_backoff() - backoff to zero or max setpoint positions
+ */
+static stat_t _homing_group_setpoint_backoff(int8_t axis)
+{
+    float travel[AXES] = INIT_AXES_ZEROES;
+    float velocity[AXES] = INIT_AXES_ZEROES;
+
+    if (hm.latched_motors != hm.group_motors) {
+        return (_homing_group_not_latched(axis));
+    }
+    _homing_group_sync();
+    for (uint8_t a = AXIS_X; a < AXES; a++) {
+        if (hm.group_axes[a]) {
+            travel[a] = hm.a[a].zero_backoff;
+            velocity[a] = hm.a[a].search_velocity;
+        }
+    }
+    _homing_group_move(axis, travel, velocity, false);
+    return (_set_homing_func(_homing_group_set_position));
+}
+
+/*
+ * _homing_group_set_position() - set the group's axes to their setpoints and finish up
+ *
+ *  A G28.4 cycle leaves the axes where the steps say they are
+ */
+static stat_t _homing_group_set_position(int8_t axis)
+{
+    _homing_group_sync();
+    if (hm.set_coordinates) {
+        for (uint8_t a = AXIS_X; a < AXES; a++) {
+            if (hm.group_axes[a]) {
+                cm_set_position_by_axis(a, hm.a[a].setpoint);
+                cm->homed[a] = true;
+            }
+        }
+    }
+    hm.group = false;
+    din_handlers[INPUT_ACTION_INTERNAL].deregisterHandler(&_homing_handler);  // end homing mode
+    return (_set_homing_func(_homing_axis_start));
+}
+
+/*
+ * _homing_group_move() - move the group's axes by travel, each at no more than its velocity
+ *
+ *  Motors are stopped by their inputs only if stop_on_inputs is set - not when clearing the
+ *  switches, where they might bounce. Axes with no travel don't move. Returns STAT_OK
+ *  without moving if none have travel.
+ */
+static stat_t _homing_group_move(int8_t axis, const float travel[], const float velocity[], bool stop_on_inputs)
+{
+    float vect[]  = INIT_AXES_ZEROES;
+    bool  flags[] = INIT_AXES_ZEROES;
+    float time = 0;                         // minutes for the slowest axis
+    float length = 0;
+
+    for (uint8_t a = AXIS_X; a < AXES; a++) {
+        if (hm.group_axes[a] && fp_NOT_ZERO(travel[a])) {
+            vect[a]  = travel[a];
+            flags[a] = true;
+            time = std::max(time, std::abs(travel[a]) / velocity[a]);
+            length += square(travel[a]);
+        }
+    }
+    if (fp_ZERO(time)) {
+        return (STAT_OK);
+    }
+
+    hm.latched_motors = stop_on_inputs ? 0 : hm.group_motors;
+    hm.waiting_for_motion_end = true;
+    cm_set_feed_rate(sqrt(length) / time);
+
+    stat_t status = cm_straight_feed(vect, flags, PROFILE_FAST);
+    if (status != STAT_OK) {
+        rpt_exception(status, "Homing move failed. Check min/max settings");
+        return (_homing_error_exit(axis, STAT_HOMING_CYCLE_FAILED));
+    }
+
+    // the last two arguments are ignored anyway
+    mp_queue_command(_homing_axis_move_callback, nullptr, nullptr);
+
+    return (STAT_EAGAIN);
+}
+
+/*
+ * _homing_group_sync() - unlock the motors and set the group's axes to where the steps put them
+ *
+ *  The planner doesn't know which motors were locked, so the runtime position is wrong for
+ *  their axes. Setting the position also sets every motor on an axis to that position.
+ */
+static void _homing_group_sync()
+{
+    float steps[MOTORS];
+    float position[AXES];
+
+    st_unlock_motors();
+    for (uint8_t motor = MOTOR_1; motor < MOTORS; motor++) {
+        steps[motor] = en_read_encoder(motor);
+    }
+    kn_forward_kinematics(steps, position);
+    for (uint8_t a = AXIS_X; a < AXES; a++) {
+        if (hm.group_axes[a]) {
+            cm_set_position_by_axis(a, position[a]);
+        }
+    }
+}
+
+/*
+ * _homing_group_not_latched() - fail the cycle as a motor's input didn't trip in the search or latch
+ *
+ *  That motor ran the whole move - against the hard stop if its input is wired to some other
+ *  switch - so the gantry can't be taken as square, or homed.
+ */
+static stat_t _homing_group_not_latched(int8_t axis)
+{
+    for (uint8_t motor = MOTOR_1; motor < MOTORS; motor++) {
+        if ((hm.group_motors & ~hm.latched_motors) & (1 << motor)) {
+            axis = st_cfg.mot[motor].motor_map;
+            break;
+        }
+    }
+    _homing_group_sync();                   // leave the position where the steps are
+    return (_homing_error_exit(axis, STAT_HOMING_CYCLE_FAILED));
+}
+
+
 /***********************************************************************************
  * _homing_error_exit()
  *
@@ -474,6 +862,8 @@ static stat_t _homing_finalize_exit(int8_t axis)  // third part of return to hom
 
     // This is idempotent - if it's not there, no worries
     din_handlers[INPUT_ACTION_INTERNAL].deregisterHandler(&_homing_handler);  // end homing mode
+    hm.group = false;
+    st_unlock_motors();
 
     return (STAT_OK);
 }
@@ -36,6 +36,8 @@
 #include "xio.h"
 
 #define JOGGING_START_VELOCITY ((float)10.0)
+#define JOGGING_SEGMENT_MS     ((float)10.0)                        // velocity jog segment time
+#define JOGGING_SEGMENT_TIME   ((float)(JOGGING_SEGMENT_MS / 60000)) // DO NOT CHANGE - time in minutes
 
 /**** Jogging singleton structure ****/
 
@@ -48,6 +50,11 @@ struct jmJoggingSingleton {         // persistent jogging runtime variables
     float   velocity_max;
     uint8_t step;                   // what step of the ramp the jogging cycle is currently on
 
+    // velocity jogging
+    bool    continuous;             // true for a velocity jog, false for a jog to a destination
+    float   velocity[AXES];         // jog velocity vector in mm/min (or deg/min)
+    Timeout keepalive;              // the velocity jog stops when this runs out
+
     uint8_t (*func)(int8_t axis);   // binding for callback function state machine
 
     // state saved from gcode model
@@ -66,6 +73,7 @@ static stat_t _set_jogging_func(uint8_t (*func)(int8_t axis));
 static stat_t _jogging_axis_start(int8_t axis);
 static stat_t _jogging_axis_ramp_jog(int8_t axis);
 static stat_t _jogging_axis_move(int8_t axis, float target, float velocity);
+static stat_t _jogging_velocity(int8_t axis);
 static stat_t _jogging_finalize_exit(int8_t axis);
 
 /*****************************************************************************
@@ -106,6 +114,7 @@ stat_t cm_jogging_cycle_start(uint8_t axis) {
     jog.step = 0;
 
     jog.axis = axis;
+    jog.continuous = false;
     jog.func = _jogging_axis_start;  // bind initial processing function
 
     cm->machine_state = MACHINE_CYCLE;
@@ -114,12 +123,80 @@ stat_t cm_jogging_cycle_start(uint8_t axis) {
     return (STAT_OK);
 }
 
+/*****************************************************************************
+ * cm_jogging_velocity() - start or steer a velocity jog, and keep it alive
+ *
+ *  {"jgv":{"x":1200,"y":-300}} jogs at a velocity vector in mm/min (deg/min for rotary
+ *  axes) in machine coordinates, instead of to a destination. It's for pendants and jog
+ *  buttons - the host keeps sending jgv while the button is held. The jog stops once no jgv
+ *  has arrived for the keep-alive time ($jvt, in ms), when all velocities are set to zero,
+ *  or on a feedhold. Axes not given in a jgv keep their velocity. Velocities are limited to
+ *  the axes' max feed rates.
+ *
+ *  The jog is queued as short segments, and only as far ahead of the runtime as it takes
+ *  to stop from the jog velocity, plus a couple of segments. The planner always plans the
+ *  queue to end stopped, so not queueing any more segments is a jerk-limited stop that
+ *  starts within two segment times. Jogging to a destination instead runs everything it
+ *  has queued before it stops.
+ *
+ *  Homed axes stop at their soft limits if soft limits are enabled.
+ */
+
+stat_t cm_jogging_velocity(uint8_t axis, float velocity) {
+    if (cm->cycle_type == CYCLE_JOG) {
+        if (!jog.continuous) {
+            return (STAT_COMMAND_NOT_ACCEPTED);         // a jog to a destination is running
+        }
+    } else {
+        if (fp_ZERO(velocity)) {
+            return (STAT_OK);                           // nothing to start
+        }
+        ritorno(cm_is_alarmed());
+        if ((cm->machine_state == MACHINE_CYCLE) || (cm->machine_state == MACHINE_INTERLOCK) ||
+            (cm->hold_state != FEEDHOLD_OFF)) {
+            return (STAT_COMMAND_NOT_ACCEPTED);
+        }
+        jog.saved_units_mode     = cm_get_units_mode(ACTIVE_MODEL);
+        jog.saved_coord_system   = cm_get_coord_system(ACTIVE_MODEL);
+        jog.saved_distance_mode  = cm_get_distance_mode(ACTIVE_MODEL);
+        jog.saved_feed_rate_mode = cm_get_feed_rate_mode(ACTIVE_MODEL);
+        jog.saved_feed_rate      = (ACTIVE_MODEL)->feed_rate;
+
+        cm_set_units_mode(MILLIMETERS);
+        cm_set_distance_mode(ABSOLUTE_DISTANCE_MODE);
+        cm_set_coord_system(ABSOLUTE_COORDS);           // jogging is done in machine coordinates
+        cm_set_feed_rate_mode(INVERSE_TIME_MODE);       // segments are timed, whatever axes move
+
+        for (uint8_t i = AXIS_X; i < AXES; i++) {
+            jog.velocity[i] = 0;
+        }
+        jog.continuous = true;
+        jog.axis = axis;
+        jog.func = _jogging_velocity;
+
+        cm->machine_state = MACHINE_CYCLE;
+        cm->cycle_type = CYCLE_JOG;
+        sr_request_status_report(SR_REQUEST_IMMEDIATE);
+    }
+
+    float velocity_max = cm->a[axis].feedrate_max;
+    jog.velocity[axis] = std::max(-velocity_max, std::min(velocity, velocity_max));
+    jog.keepalive.set(cm->jogging_keepalive);
+
+    // a jog that's stopping can be picked up again
+    if ((jog.func == _jogging_finalize_exit) && (cm->hold_state == FEEDHOLD_OFF)) {
+        jog.func = _jogging_velocity;
+    }
+    return (STAT_OK);
+}
+
 /* Jogging axis moves - these execute in sequence for each axis
  * cm_jogging_cycle_callback()  - main loop callback for running the jogging cycle
  *  _set_jogging_func()         - a convenience for setting the next dispatch vector and exiting
  *  _jogging_axis_start()       - setup the jog
  *  _jogging_axis_ramp_jog()    - ramp the jog
  *  _jogging_axis_move()        - move the axis
+ *  _jogging_velocity()         - queue the velocity jog
  *  _jogging_finalize_exit()    - clean up
  */
 
@@ -131,7 +208,7 @@ stat_t cm_jogging_cycle_callback(void) {
         return (STAT_EAGAIN);  // sync to planner move ends
     }
     //    if (jog.func == _jogging_axis_ramp_jog && mp_get_buffers_available() < PLANNER_BUFFER_HEADROOM) {
-    if (jog.func == _jogging_axis_ramp_jog && mp_planner_is_full(mp)) {     // +++++
+    if ((jog.func == _jogging_axis_ramp_jog || jog.func == _jogging_velocity) && mp_planner_is_full(mp)) {
         return (STAT_EAGAIN);  // prevent flooding the queue with jog moves
     }
     return (jog.func(jog.axis));  // execute the current jogging move
@@ -187,6 +264,59 @@ static stat_t _jogging_axis_move(int8_t axis, float target, float velocity) {
     return (STAT_EAGAIN);
 }
 
+static stat_t _jogging_velocity(int8_t axis)
+{
+    // stop by queueing no more - what's queued already ends in a stop
+    float speed = 0;
+    for (uint8_t i = AXIS_X; i < AXES; i++) {
+        speed += square(jog.velocity[i]);
+    }
+    speed = sqrt(speed);
+    if (fp_ZERO(speed) || jog.keepalive.isPast() || (cm->hold_state != FEEDHOLD_OFF)) {
+        for (uint8_t i = AXIS_X; i < AXES; i++) {
+            jog.velocity[i] = 0;
+        }
+        return (_set_jogging_func(_jogging_finalize_exit));
+    }
+
+    // distance to stop at the jog velocity, with the jerk the planner uses for the direction
+    float unit[AXES];
+    for (uint8_t i = AXIS_X; i < AXES; i++) {
+        unit[i] = jog.velocity[i] / speed;
+    }
+    float stopping_length = mp_get_stopping_length(speed, mp_get_jerk(unit, PROFILE_FAST));
+    float segment_length = speed * JOGGING_SEGMENT_TIME;
+
+    // queue a segment if the queue is getting short of the stopping distance
+    float position[AXES];
+    float target[AXES];
+    bool  flags[AXES];
+    float ahead = 0;
+    float length = 0;
+    for (uint8_t i = AXIS_X; i < AXES; i++) {
+        position[i] = cm_get_absolute_position(MODEL, i);
+        ahead += square(position[i] - cm_get_absolute_position(RUNTIME, i));
+
+        target[i] = position[i] + jog.velocity[i] * JOGGING_SEGMENT_TIME;
+        if (cm->soft_limit_enable && cm->homed[i] && !fp_EQ(cm->a[i].travel_min, cm->a[i].travel_max) &&
+            (fabs(cm->a[i].travel_min) <= DISABLE_SOFT_LIMIT) && (fabs(cm->a[i].travel_max) <= DISABLE_SOFT_LIMIT)) {
+            target[i] = std::max(cm->a[i].travel_min, std::min(target[i], cm->a[i].travel_max));
+        }
+        flags[i] = fp_NOT_ZERO(target[i] - position[i]);
+        length += square(target[i] - position[i]);
+    }
+    if (sqrt(ahead) > stopping_length + segment_length) {
+        return (STAT_EAGAIN);
+    }
+    length = sqrt(length);
+    if (fp_ZERO(length)) {
+        return (STAT_EAGAIN);                           // at the soft limits - wait for a new direction
+    }
+    cm_set_feed_rate(speed / length);                   // inverse time - 1/minutes for the segment
+    ritorno(cm_straight_feed(target, flags, PROFILE_FAST));
+    return (STAT_EAGAIN);
+}
+
 static stat_t _jogging_finalize_exit(int8_t axis)  // finish a jog
 {
     //    cm_end_hold();                                // ends hold if one is in effect
@@ -197,6 +327,7 @@ static stat_t _jogging_finalize_exit(int8_t axis)  // finish a jog
     cm_set_feed_rate_mode(jog.saved_feed_rate_mode);
     (MODEL)->feed_rate = jog.saved_feed_rate;
     cm_set_motion_mode(MODEL, MOTION_MODE_CANCEL_MOTION_MODE);
+    jog.continuous = false;
     cm_canned_cycle_end();
     xio_writeline("{\"jog\":0}\n");  // needed by OMC jogging function
     return (STAT_OK);
@@ -62,6 +62,17 @@ struct pbProbingSingleton {             // persistent probing runtime variables
     cmUnitsMode saved_units_mode;       // G20,G21 setting
     cmDistanceMode saved_distance_mode; // G90,G91 global setting
     bool saved_soft_limits;             // turn off soft limits during probing
+
+    // G29.1 grid probe - all positions in machine coordinates (mm)
+    bool grid;                          // true if running a grid probe instead of a G38.x probe
+    float grid_origin[2];               // X and Y of the first point
+    float grid_spacing[2];              // distance between points in X and Y
+    uint8_t grid_columns;               // points along X
+    uint8_t grid_rows;                  // points along Y
+    uint8_t grid_point;                 // point being probed, row by row from the origin
+    float grid_clearance;               // Z to travel between points - where the cycle starts
+    float grid_depth;                   // Z to probe down to
+    float grid_reference;               // Z of the first contact - heights are relative to it
 };
 static struct pbProbingSingleton pb;
 
@@ -71,9 +82,16 @@ static stat_t _probing_start();
 static stat_t _probing_backoff();
 static stat_t _probing_finish();
 static stat_t _probing_exception_exit(stat_t status);
+static void _probe_restore_settings();
 static stat_t _probe_move(const float target[], const bool flags[]);
 static void _send_probe_report(void);
 
+static stat_t _grid_start();
+static stat_t _grid_move_to_point();
+static stat_t _grid_probe_point();
+static stat_t _grid_record_point();
+static stat_t _grid_finish();
+
 void _prepare_for_probe();
 void _store_probe_position();
 
@@ -129,13 +147,13 @@ static void _motion_end_callback(float* vect, bool* flag)
  *   Will be registered only during homing mode - see gpio.h for more info
  */
 gpioDigitalInputHandler _probing_handler {
-    [&](const bool state, const inputEdgeFlag edge, const uint8_t triggering_pin_number) {
+    [](const bool state, const inputEdgeFlag edge, const uint8_t triggering_pin_number) {
         if (cm->cycle_type != CYCLE_PROBE) { return GPIO_NOT_HANDLED; }
         if (triggering_pin_number != pb.probe_input) { return GPIO_NOT_HANDLED; }
 
         // If the probe tripped, and the pin changes again, don't unset it! So, use |=
         pb.probe_tripped |= (state == pb.trip_sense);
-        en_take_encoder_snapshot();
+        en_take_encoder_snapshot(din_edge_ticks);
         cm_request_feedhold(FEEDHOLD_TYPE_SKIP, FEEDHOLD_EXIT_STOP);
 
         return GPIO_HANDLED; // DO NOT allow others to see this notice (particularly limits)
@@ -161,7 +179,9 @@ gpioDigitalInputHandler _probing_handler {
  *  https://github.com/synthetos/g2/wiki/Gcode-Probes
  *
  *  When the probe input fires the input interrupt takes a snapshot of the internal
- *  encoders, then requests a "high speed" feedhold. We then run forward kinematics
+ *  encoders, extrapolated back to the DDA tick the edge was timestamped at (so the
+ *  input dispatch time doesn't add probe error at higher feed rates), then requests
+ *  a "high speed" feedhold. We then run forward kinematics
  *  on the encoder snapshot to get the reported position. We also execute a move
  *  from the final position (after the feedhold) back to the point we report.
  *
@@ -290,7 +310,15 @@ void cm_abort_probing(cmMachine_t *_cm) {
 
     // The cycle_type may have already been changed, but if it hasn't do so now
     if (_cm->cycle_type == CYCLE_PROBE) {
-        _probing_finish();
+        if (pb.grid) {
+            _probe_restore_settings();
+        } else {
+            _probing_finish();
+        }
+    }
+    if (pb.grid) {
+        mp_mesh_finish(false);          // the map is incomplete - leave compensation off
+        pb.grid = false;
     }
 
     // This is idempotent - if it's not there, no worries
@@ -353,7 +381,9 @@ static uint8_t _probing_start()
         return(_probing_exception_exit(STAT_PROBE_IS_ALREADY_TRIPPED));
     }
 
-    din_handlers[INPUT_ACTION_INTERNAL].registerHandler(&_probing_handler);
+    if (din_handlers[INPUT_ACTION_INTERNAL].registerHandler(&_probing_handler) != STAT_OK) {
+        return (_probing_exception_exit(STAT_PROBE_CYCLE_FAILED));
+    }
 
     // Everything checks out. Run the probe move
     _probe_move(pb.target, pb.flags);
@@ -408,6 +438,10 @@ static void _probe_restore_settings()
 static stat_t _probing_exception_exit(stat_t status)
 {
     _probe_restore_settings();          // cleanup first
+    if (pb.grid) {
+        mp_mesh_finish(false);
+        pb.grid = false;
+    }
     return (cm_alarm(status, "probe error"));
 }
 
@@ -427,6 +461,193 @@ static stat_t _probing_finish()
     return (STAT_OK);
 }
 
+/***********************************************************************************
+ **** G29.1 Grid Probing Cycle *****************************************************
+ ***********************************************************************************/
+
+/***********************************************************************************
+ * cm_probe_grid() - G29.1 probe a grid of points to make a height map
+ *
+ *  G29.1 X<x> Y<y> I<x extent> J<y extent> P<columns> L<rows> Z<depth> F<feed>
+ *
+ *  Probes a grid of P columns by L rows, starting at X,Y and extending I in X and J in Y,
+ *  and makes it the height map for Z compensation (see plan_mesh.cpp). Each point is
+ *  probed down toward Z at the F feed rate, starting from the Z the cycle started at,
+ *  which the cycle returns to between points. X, Y and Z are in work coordinates, like
+ *  G38.2. Like G38.2 it's an alarm if any point fails to make contact.
+ *
+ *  Each contact is reported as a probe report and stored as the latest probe. The heights
+ *  are relative to the first point, and persisted. Compensation is enabled when the grid
+ *  completes, and left disabled if the cycle fails or is aborted.
+ */
+
+stat_t cm_probe_grid(const float target[], const bool flags[],
+                     const float extent[], const bool extent_flags[],
+                     const float P_word, const bool P_flag,
+                     const uint8_t L_word, const bool L_flag)
+{
+    if (cm->cycle_type == CYCLE_PROBE) {
+        return(cm_alarm(STAT_PROBE_CYCLE_FAILED, "Already probing - cannot start another probe"));
+    }
+    if (!(flags[AXIS_X] && flags[AXIS_Y] && flags[AXIS_Z])) {
+        return (STAT_AXIS_IS_MISSING);
+    }
+    if (!(extent_flags[0] && extent_flags[1]) || fp_ZERO(extent[0]) || fp_ZERO(extent[1])) {
+        return (STAT_GCODE_GENERIC_INPUT_ERROR);
+    }
+    if (!P_flag) {
+        return (STAT_P_WORD_IS_MISSING);
+    }
+    if ((P_word < 2) || (P_word > MESH_COLUMNS_MAX) || (P_word != floor(P_word))) {
+        return (STAT_P_WORD_IS_INVALID);
+    }
+    if (!L_flag) {
+        return (STAT_L_WORD_IS_MISSING);
+    }
+    if ((L_word < 2) || (L_word > MESH_ROWS_MAX)) {
+        return (STAT_L_WORD_IS_INVALID);
+    }
+    if (fp_ZERO(cm->gm.feed_rate)) {
+        return(cm_alarm(STAT_FEEDRATE_NOT_SPECIFIED, "Feedrate is zero"));
+    }
+    if ((pb.probe_input = cm->probe_input) == -1) {
+        return(cm_alarm(STAT_NO_PROBE_INPUT_CONFIGURED, "Probe input not configured"));
+    }
+
+    cm_set_model_target(target, flags);     // convert X, Y and Z to machine coordinates
+    float units = (cm_get_units_mode(MODEL) == INCHES) ? MM_PER_INCH : 1;
+    pb.grid_columns = (uint8_t)P_word;
+    pb.grid_rows = L_word;
+    for (uint8_t i=0; i<2; i++) {
+        pb.grid_origin[i] = cm->gm.target[AXIS_X+i];
+        pb.grid_spacing[i] = extent[i] * units / ((i == 0 ? pb.grid_columns : pb.grid_rows) - 1);
+    }
+    pb.grid_depth = cm->gm.target[AXIS_Z];
+    pb.grid_clearance = cm->gmx.position[AXIS_Z]; // where the queued motion leaves Z
+    if ((pb.grid_clearance - pb.grid_depth) < MINIMUM_PROBE_TRAVEL) {
+        return(cm_alarm(STAT_PROBE_TRAVEL_TOO_SMALL, "Grid probe Z must be below the start"));
+    }
+
+    pb.grid = true;
+    pb.alarm_flag = true;                   // a point that doesn't make contact is an alarm
+    pb.trip_sense = true;                   // probe on contact closure, like G38.2
+    pb.func = _grid_start;
+
+    _prepare_for_probe();
+
+    // queue a function to let us know when we can start probing
+    cm->probe_state[0] = PROBE_WAITING;
+    pb.waiting_for_motion_complete = true;
+    pb.probe_tripped = false;
+    mp_queue_command(_motion_end_callback, nullptr, nullptr);  // note: these args are ignored
+    return (STAT_OK);
+}
+
+/***********************************************************************************
+ * _grid_start()         - set up the cycle and start the height map
+ * _grid_move_to_point() - rise to the clearance Z and traverse over the next point
+ * _grid_probe_point()   - probe down at the point
+ * _grid_record_point()  - record the contact, then move to the next point or finish
+ * _grid_finish()        - runs after the return to clearance at the last point
+ */
+
+static stat_t _grid_start()
+{
+    cm->probe_state[0] = PROBE_FAILED;
+    cm->machine_state = MACHINE_CYCLE;
+    cm->cycle_type = CYCLE_PROBE;
+
+    // save relevant non-axis parameters from Gcode model
+    pb.saved_distance_mode = (cmDistanceMode)cm_get_distance_mode(ACTIVE_MODEL);
+    pb.saved_units_mode = (cmUnitsMode)cm_get_units_mode(ACTIVE_MODEL);
+    pb.saved_soft_limits = cm_get_soft_limits();
+    cm_set_soft_limits(false);
+
+    // set working values
+    cm_set_distance_mode(ABSOLUTE_DISTANCE_MODE);
+    cm_set_units_mode(MILLIMETERS);
+
+    mp_mesh_start(pb.grid_origin, pb.grid_spacing, pb.grid_columns, pb.grid_rows);
+    pb.grid_point = 0;
+    return (_grid_move_to_point());
+}
+
+static stat_t _grid_move_to_point()
+{
+    float target[AXES];
+    bool flags[AXES] = {};
+    copy_vector(target, cm->gmx.position);
+    target[AXIS_Z] = pb.grid_clearance;
+    flags[AXIS_Z] = true;
+
+    cm_set_absolute_override(MODEL, ABSOLUTE_OVERRIDE_ON_DISPLAY_WITH_OFFSETS);
+    pb.waiting_for_motion_complete = true;          // set this BEFORE the motion starts
+    cm_straight_traverse(target, flags, PROFILE_NORMAL);
+    if (pb.grid_point < (pb.grid_columns * pb.grid_rows)) {
+        target[AXIS_X] = pb.grid_origin[0] + pb.grid_spacing[0] * (pb.grid_point % pb.grid_columns);
+        target[AXIS_Y] = pb.grid_origin[1] + pb.grid_spacing[1] * (pb.grid_point / pb.grid_columns);
+        flags[AXIS_X] = true;
+        flags[AXIS_Y] = true;
+        flags[AXIS_Z] = false;
+        cm_straight_traverse(target, flags, PROFILE_NORMAL);
+        pb.func = _grid_probe_point;
+    } else {
+        pb.func = _grid_finish;
+    }
+    mp_queue_command(_motion_end_callback, nullptr, nullptr);
+    return (STAT_EAGAIN);
+}
+
+static stat_t _grid_probe_point()
+{
+    if (pb.trip_sense == gpio_read_input(pb.probe_input)) {
+        return(_probing_exception_exit(STAT_PROBE_IS_ALREADY_TRIPPED));
+    }
+    pb.probe_tripped = false;
+    if (din_handlers[INPUT_ACTION_INTERNAL].registerHandler(&_probing_handler) != STAT_OK) {
+        return (_probing_exception_exit(STAT_PROBE_CYCLE_FAILED));
+    }
+
+    float target[AXES];
+    bool flags[AXES] = {};
+    copy_vector(target, cm->gmx.position);
+    target[AXIS_Z] = pb.grid_depth;
+    flags[AXIS_Z] = true;
+    _probe_move(target, flags);
+    pb.func = _grid_record_point;
+    return (STAT_EAGAIN);
+}
+
+static stat_t _grid_record_point()
+{
+    din_handlers[INPUT_ACTION_INTERNAL].deregisterHandler(&_probing_handler);
+    if (!pb.probe_tripped) {
+        return(_probing_exception_exit(STAT_PROBE_CYCLE_FAILED));
+    }
+
+    // record the contact as the latest probe - compensation is off, so this is the real Z
+    _prepare_for_probe();
+    cm->probe_state[0] = PROBE_SUCCEEDED;
+    kn_forward_kinematics(en_get_encoder_snapshot_vector(), cm->probe_results[0]);
+    _send_probe_report();
+
+    float z = cm->probe_results[0][AXIS_Z];
+    if (pb.grid_point == 0) {
+        pb.grid_reference = z;
+    }
+    mp_mesh_set_height(pb.grid_point % pb.grid_columns, pb.grid_point / pb.grid_columns, z - pb.grid_reference);
+    pb.grid_point++;
+    return (_grid_move_to_point());
+}
+
+static stat_t _grid_finish()
+{
+    _probe_restore_settings();
+    mp_mesh_finish(true);
+    pb.grid = false;
+    return (STAT_OK);
+}
+
 /*
  * _probe_report() - report probe results - must update results vector first
  */
@@ -59,6 +59,8 @@ class ESCSpindle : public ToolHead {
 
     bool this_change_holds_motion = false;
 
+    spMode mode = SPINDLE_MODE_PLAN_TO_STOP;  // how S word changes are applied
+
     float speed_min;              // minimum settable spindle speed
     float speed_max;              // maximum settable spindle speed
 
@@ -67,30 +69,6 @@ class ESCSpindle : public ToolHead {
     float speed_change_per_tick;  // speed ramping rate per tick (ms)
     float spinup_delay;           // optional delay on spindle start (set to 0 to disable)
 
-    struct speedToPhase {
-        float speed_lo;              // minimum spindle speed [0..N]
-        float speed_hi;              // maximum spindle speed
-
-        float phase_lo;              // pwm phase at minimum spindle speed, clamped [0..1]
-        float phase_hi;              // pwm phase at maximum spindle speed, clamped [0..1]
-
-        float k_value;                  // pwm k value to control curve slope
-
-        // convert a speed value in the range of (speed_lo .. speed_hi)
-        // to a value in the range of (phase_lo .. phase_hi)
-        float speed_to_phase(float speed) {
-            
-            // Clamp speed to the [speed_lo, speed_hi] range
-            speed = (std::max(speed_lo, std::min(speed_hi, speed)) - speed_lo) / (speed_hi - speed_lo);
-
-            // Apply a power curve that weights towards phase_low
-            // The exponent (k > 1) determines the curvature
-            float curved_speed = std::pow(speed, k_value);
-
-            return (curved_speed * (phase_hi - phase_lo)) + phase_lo;
-        }
-    };
-
     speedToPhase cw;                // clockwise speed and phase settings
     speedToPhase ccw;               // counter-clockwise speed and phase settings
 
@@ -166,7 +144,8 @@ class ESCSpindle : public ToolHead {
     bool busy() override;             // return true if motion should continue waiting for this toolhead
 
     // the result of an S word
-    // DON'T override set_speed - use engage instead
+    // only says if a command is needed - the speed is taken from engage or engage_speed
+    bool set_speed(float speed) override;
     float get_speed() override;
 
     // the result of an M3/M4/M5
@@ -186,6 +165,12 @@ class ESCSpindle : public ToolHead {
     // called from the loader right before a move, with the gcode model to use
     void engage(const GCodeState_t &gm) override;
 
+    // called from the loader right before each segment of a move, with the S word of that move
+    void engage_segment(float new_speed, float velocity_factor) override;
+
+    void set_mode(spMode new_mode) override { mode = new_mode; }
+    spMode get_mode() override { return mode; }
+
     bool is_on() override;  // return if the current direction is anything but OFF, **even if paused**
 
     bool set_pwm_output(const uint8_t pwm_pin_number) override;
@@ -237,7 +222,7 @@ class ESCSpindle : public ToolHead {
     void set_phase_off(float new_phase_off) override { phase_off = new_phase_off; }
     float get_phase_off() override { return phase_off; }
 
-    void set_k_value(float new_k_value) override { cw.k_value = new_k_value; ccw.k_value = new_k_value; }
+    void set_k_value(float new_k_value) override { cw.set_k_value(new_k_value); ccw.set_k_value(new_k_value); }
     float get_k_value() override { return cw.k_value; }
 };
 
@@ -293,7 +278,8 @@ bool ESCSpindle::busy() {
     return true;
 }
 
-// DON'T override set_speed - use engage instead
+// in continuous mode the S word rides along with the moves and no command is queued
+bool ESCSpindle::set_speed(float speed) { return (mode != SPINDLE_MODE_CONTINUOUS); }
 float ESCSpindle::get_speed() { return speed_actual; }
 
 // set the override value for spindle speed
@@ -341,14 +327,28 @@ void ESCSpindle::engage(const GCodeState_t &gm) {
         speed_actual = 0;
     }
 
+    // in continuous mode only a start, stop or reversal holds motion - speed changes ramp under the moves
+    if ((mode != SPINDLE_MODE_CONTINUOUS) || (gm.spindle_direction != direction)) {
+        this_change_holds_motion = true;
+    }
+
     speed = gm.spindle_speed;
     direction = gm.spindle_direction;
-    this_change_holds_motion = true;
 
     // handle the rest
     this->complete_change();
 }
 
+// called from the loader right before each segment of a move
+// in continuous mode this is where an S word takes effect - the ramp runs while the move does
+void ESCSpindle::engage_segment(float new_speed, float velocity_factor) {
+    if ((mode != SPINDLE_MODE_CONTINUOUS) || fp_EQ(speed, new_speed)) {
+        return;
+    }
+    speed = new_speed;
+    this->complete_change();
+}
+
 bool ESCSpindle::is_on() { return (direction != SPINDLE_OFF); }
 
 // ESCSpindle-specific functions
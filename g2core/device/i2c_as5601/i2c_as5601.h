@@ -35,6 +35,7 @@
 #define i2c_as5601_h
 
 #include "MotateTWI.h"
+#include "MotateTimers.h"     // for SysTickTimer and SysTickEvent
 // #include "MotateBuffer.h"
 #include "MotateUtilities.h"  // for to/fromLittle/BigEndian
 
@@ -95,14 +96,17 @@ class I2C_AS5601 final : public ExternalEncoder, public gpioDigitalInputHandler
     // static const uint8_t dev_address_ = 0x40; // AS5600L
     static const uint8_t dev_address_ = 0x36; // AS5601
 
+    // When polled (see I2C_AS5601_Poller) only the poller starts reads, and a request
+    // just asks for the result of the next one
+    bool polled_ = false;
+    volatile bool reading_requested_ = false;
+    volatile uint32_t sample_time_ = 0;     // SysTick time (ms) the last read completed
+
    public:
     template <typename TWIBus_t, typename... Ts>
     I2C_AS5601(TWIBus_t &twi_bus, int8_t quadrature_a_input, int8_t quadrature_b_input,
                std::function<void(bool, float)> &&interrupt_, Ts... v)
-        : gpioDigitalInputHandler{[&](const bool state, const inputEdgeFlag edge, const int8_t triggering_pin_number) {
-                                      return this->handleQuadrature(state, edge, triggering_pin_number);
-                                  },
-                                  5, nullptr},
+        : gpioDigitalInputHandler{gpioDigitalInputCallback::bind<I2C_AS5601, &I2C_AS5601::handleQuadrature>(this), 5, nullptr},
           device_{twi_bus.getDevice({dev_address_, TWIDeviceAddressSize::k7Bit}, v...)},
           interrupt_handler_{std::move(interrupt_)},
           quadrature_a_input_{quadrature_a_input},
@@ -112,10 +116,7 @@ class I2C_AS5601 final : public ExternalEncoder, public gpioDigitalInputHandler
 
     template <typename TWIBus_t, typename... Ts>
     I2C_AS5601(TWIBus_t &twi_bus, int8_t quadrature_a_input, int8_t quadrature_b_input, std::function<void(bool, float)> &interrupt_, Ts... v)
-        : gpioDigitalInputHandler{[&](const bool state, const inputEdgeFlag edge, const int8_t triggering_pin_number) {
-                                      return this->handleQuadrature(state, edge, triggering_pin_number);
-                                  },
-                                  5, nullptr},
+        : gpioDigitalInputHandler{gpioDigitalInputCallback::bind<I2C_AS5601, &I2C_AS5601::handleQuadrature>(this), 5, nullptr},
           device_{twi_bus.getDevice({dev_address_, TWIDeviceAddressSize::k7Bit}, v...)},
           interrupt_handler_{interrupt_},
           quadrature_a_input_{quadrature_a_input},
@@ -125,10 +126,7 @@ class I2C_AS5601 final : public ExternalEncoder, public gpioDigitalInputHandler
 
     template <typename TWIBus_t, typename... Ts>
     I2C_AS5601(TWIBus_t &twi_bus, int8_t quadrature_a_input, int8_t quadrature_b_input, Ts... v)
-        : gpioDigitalInputHandler{[&](const bool state, const inputEdgeFlag edge, const int8_t triggering_pin_number) {
-                                      return this->handleQuadrature(state, edge, triggering_pin_number);
-                                  },
-                                  5, nullptr},
+        : gpioDigitalInputHandler{gpioDigitalInputCallback::bind<I2C_AS5601, &I2C_AS5601::handleQuadrature>(this), 5, nullptr},
           device_{twi_bus.getDevice({dev_address_, TWIDeviceAddressSize::k7Bit}, v...)},
           quadrature_a_input_{quadrature_a_input},
           quadrature_b_input_{quadrature_b_input} {
@@ -137,7 +135,9 @@ class I2C_AS5601 final : public ExternalEncoder, public gpioDigitalInputHandler
 
     // Prevent copying, and prevent moving (so we know if it happens)
     I2C_AS5601(const I2C_AS5601 &) = delete;
-    I2C_AS5601(I2C_AS5601 &&other) : device_{std::move(other.device_)} {};
+    I2C_AS5601(I2C_AS5601 &&other)
+        : gpioDigitalInputHandler{gpioDigitalInputCallback::bind<I2C_AS5601, &I2C_AS5601::handleQuadrature>(this), 5, nullptr},
+          device_{std::move(other.device_)} {};
 
     void init() {
         state_ = INIT;
@@ -163,7 +163,7 @@ class I2C_AS5601 final : public ExternalEncoder, public gpioDigitalInputHandler
 
     void requestAngleDegrees() override {
         return_format_ = ReturnDegrees;
-        getPos_();
+        request_();
     }
 
     // void getAngleDegrees(std::function<void(bool, float)> &&handler) {
@@ -180,7 +180,7 @@ class I2C_AS5601 final : public ExternalEncoder, public gpioDigitalInputHandler
 
     void requestAngleRadians() override {
         return_format_ = ReturnRadians;
-        getPos_();
+        request_();
     }
 
     // void getAngleRadians(std::function<void(bool, float)> &&handler) {
@@ -197,7 +197,7 @@ class I2C_AS5601 final : public ExternalEncoder, public gpioDigitalInputHandler
 
     void requestAngleFraction() override {
         return_format_ = ReturnFraction;
-        getPos_();
+        request_();
     }
 
 
@@ -213,8 +213,22 @@ class I2C_AS5601 final : public ExternalEncoder, public gpioDigitalInputHandler
     //     getPos_();
     // }
 
+    // Polled mode interface
+    void setPolled(const bool polled) { polled_ = polled; }
+    bool canSample() const { return (state_ == IDLE) || (state_ == INIT); }
+    void sample() { getPos_(); }
+    uint32_t getSampleTime() override { return sample_time_; }
+
    private:
     uint8_t fails_ = 0;
+    void request_() {
+        if (polled_) {
+            reading_requested_ = true;
+            return;
+        }
+        getPos_();
+    }
+
     void getPos_() {
         if (state_ == INIT) {
             buffer_[0] = 15;
@@ -266,14 +280,26 @@ class I2C_AS5601 final : public ExternalEncoder, public gpioDigitalInputHandler
         if (old_state == SETUP) {
             getPos_(); // restart the request
         }
-        else if (old_state == READING_ANGLE && interrupt_handler_) {
-            if (!worked) {
-                interrupt_handler_(false, 0.0);
-            } else {
+        else if (old_state == READING_ANGLE) {
+            sample_time_ = Motate::SysTickTimer.getValue();
+            if (worked) {
                 position_ = (buffer_[0] << 8) | buffer_[1];
                 if (pins_position_ == -1) {
                     pins_position_ = position_; // sync them
                 }
+            }
+            if (polled_) {
+                if (!reading_requested_) {
+                    return;     // nobody asked for this one
+                }
+                reading_requested_ = false;
+            }
+            if (!interrupt_handler_) {
+                return;
+            }
+            if (!worked) {
+                interrupt_handler_(false, 0.0);
+            } else {
                 call_interrupt_();
             }
         }
@@ -352,4 +378,61 @@ template <typename TWIBus_t, typename... Ts>
 I2C_AS5601(TWIBus_t &, Ts...)
     ->I2C_AS5601<typename TWIBus_t::Device_t>;
 
+// Reads a set of I2C_AS5601 encoders together at a fixed sample period.
+// Every period the reads for all of the encoders are queued at once from the SysTick
+// interrupt, so the bus (and multiplexer, which injects its channel switches) plays them
+// out back-to-back as one DMA driven sequence. Read timing is then independent of main
+// loop load, and each reading is timestamped for consumers that need the latency.
+// If the previous sequence hasn't finished when the next is due, that sample is skipped
+// and counted as an overrun.
+template <typename encoder_t, uint8_t count>
+class I2C_AS5601_Poller final {
+    encoder_t *const encoders_[count];
+    const uint8_t period_ms_;
+    uint8_t countdown_;
+    volatile uint32_t batch_time_ = 0;      // SysTick time (ms) the last sequence was started
+    volatile uint16_t overruns_ = 0;
+
+    Motate::SysTickEvent tick_event_{[&] { this->tick_(); }, nullptr};
+
+   public:
+    template <typename... Ts>
+    I2C_AS5601_Poller(const uint8_t period_ms, Ts *... encoders)
+        : encoders_{encoders...}, period_ms_{period_ms}, countdown_{period_ms} {
+        static_assert(sizeof...(Ts) == count, "I2C_AS5601_Poller needs exactly count encoders");
+    }
+
+    // Prevent copying or moving - the SysTick event points back at us
+    I2C_AS5601_Poller(const I2C_AS5601_Poller &) = delete;
+    I2C_AS5601_Poller(I2C_AS5601_Poller &&) = delete;
+
+    void start() {
+        for (auto encoder : encoders_) {
+            encoder->setPolled(true);
+        }
+        Motate::SysTickTimer.registerEvent(&tick_event_);
+    }
+
+    uint32_t getBatchTime() const { return batch_time_; }
+    uint16_t getOverruns() const { return overruns_; }
+
+   private:
+    void tick_() {
+        if (--countdown_) {
+            return;
+        }
+        countdown_ = period_ms_;
+        for (auto encoder : encoders_) {
+            if (!encoder->canSample()) {
+                overruns_++;
+                return;
+            }
+        }
+        batch_time_ = Motate::SysTickTimer.getValue();
+        for (auto encoder : encoders_) {
+            encoder->sample();
+        }
+    }
+};
+
 #endif  // i2c_as5601_h
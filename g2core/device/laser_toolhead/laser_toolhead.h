@@ -0,0 +1,279 @@
+/*
+ * laser_toolhead.h - toolhead driver for a PWM-driven laser
+ * This file is part of the g2core project
+ *
+ * Copyright (c) 2026 g2core project contributors
+ *
+ * This file ("the software") is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2 as published by the
+ * Free Software Foundation. You should have received a copy of the GNU General Public
+ * License, version 2 along with the software.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, you may use this file as part of a software library without
+ * restriction. Specifically, if other files instantiate templates or use macros or
+ * inline functions from this file, or you compile this file and link it with  other
+ * files to produce an executable, this file does not by itself cause the resulting
+ * executable to be covered by the GNU General Public License. This exception does not
+ * however invalidate any other reasons why the executable file might be covered by the
+ * GNU General Public License.
+ *
+ * THE SOFTWARE IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL, BUT WITHOUT ANY
+ * WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT
+ * SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+ * OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef LASER_TOOLHEAD_H_ONCE
+#define LASER_TOOLHEAD_H_ONCE
+
+#include "spindle.h"
+#include "util.h" // for fp_ZERO
+#include "safety_manager.h" // for safety_manager
+
+/* A few notes:
+ *
+ * The laser's power is set by the PWM output, and is set for every segment as the loader starts
+ * it: S, scaled by the segment's velocity as a fraction of the move's cruise velocity, through the
+ * same speed-to-phase curve as the spindles (the p1 cw settings). So the power per length stays
+ * even through the accelerations, and the power changes with the motion instead of a main loop
+ * cycle later.
+ *
+ * S changes never stop motion - they ride along with the moves. M3/M4/M5 are queued as commands
+ * so they take effect in order with the moves.
+ *
+ * The laser is off for traverses (G0), dwells and commands, as soon as motion stops (so at the end
+ * of a feedhold's deceleration), and while paused.
+ *
+ */
+
+
+// class declaration
+// note implementation is after
+class LaserToolHead : public ToolHead {
+    spDirection direction;        // direction
+    float speed;                  // S of the segment running (or last run)
+
+    bool paused;                  // true if paused, false is not
+
+    speedToPhase power;           // S to pwm phase
+    float phase_off;              // pwm phase when the laser is off
+
+    uint8_t pwm_output_num;
+    gpioDigitalOutput *pwm_output = nullptr;
+    uint8_t enable_output_num;
+    gpioDigitalOutput *enable_output = nullptr;
+
+    void set_pwm_value(float value) {
+        if (pwm_output != nullptr) {
+            pwm_output->setValue(value);
+        }
+    }
+
+   public:
+    // constructor - provide it with the default output pins - 0 means no pin
+    // and the S value for full power
+    LaserToolHead(const uint8_t pwm_pin_number, const uint8_t enable_pin_number, const float speed_max);
+
+    // ToolHead overrides
+    void init() override;
+
+    void pause() override;          // soft-stop the toolhead (usually for a feedhold) - retain all state for resume
+    void resume() override;         // resume from the pause - return STAT_EAGAIN if it's not yet ready
+    bool ready_to_resume() override;  // return true if paused and resume would not result in an error
+
+    // the result of an S word - never needs a command, the S is taken from engage_segment
+    bool set_speed(float speed) override { return (false); }
+    float get_speed() override { return speed; }
+
+    // the result of an M3/M4/M5 - always a command, so it's in order with the moves
+    bool set_direction(spDirection direction) override { return (true); }
+    spDirection get_direction() override { return direction; }
+
+    void stop() override;
+
+    // called from the loader right before a command, with the gcode model to use
+    void engage(const GCodeState_t &gm) override;
+
+    // called from the loader right before each segment of a move
+    void engage_segment(float new_speed, float velocity_factor) override;
+
+    // called from the loader when there is no segment to run
+    void motion_stopped() override;
+
+    bool is_on() override { return (direction != SPINDLE_OFF); }
+
+    bool set_pwm_output(const uint8_t pwm_pin_number) override;
+    uint8_t get_pwm_output() override;
+    bool set_pwm_polarity(const ioPolarity new_polarity) override;
+    ioPolarity get_pwm_polarity() override;
+
+    bool set_enable_output(const uint8_t enable_pin_number) override;
+    uint8_t get_enable_output() override;
+    bool set_enable_polarity(const ioPolarity new_polarity) override;
+    ioPolarity get_enable_polarity() override;
+
+    void set_frequency(float new_frequency) override;
+    float get_frequency() override;
+
+    // trivial getters and setters - inlined
+    void set_cw_speed_lo(float new_speed_lo) override { power.speed_lo = new_speed_lo; }
+    float get_cw_speed_lo() override { return power.speed_lo; }
+    void set_cw_speed_hi(float new_speed_hi) override { power.speed_hi = new_speed_hi; }
+    float get_cw_speed_hi() override { return power.speed_hi; }
+    void set_cw_phase_lo(float new_phase_lo) override { power.phase_lo = new_phase_lo; }
+    float get_cw_phase_lo() override { return power.phase_lo; }
+    void set_cw_phase_hi(float new_phase_hi) override { power.phase_hi = new_phase_hi; }
+    float get_cw_phase_hi() override { return power.phase_hi; }
+
+    void set_phase_off(float new_phase_off) override { phase_off = new_phase_off; }
+    float get_phase_off() override { return phase_off; }
+
+    void set_k_value(float new_k_value) override { power.set_k_value(new_k_value); }
+    float get_k_value() override { return power.k_value; }
+};
+
+// method implementations follow
+
+LaserToolHead::LaserToolHead(const uint8_t pwm_pin_number, const uint8_t enable_pin_number, const float speed_max)
+    : direction{SPINDLE_OFF},
+      speed{0},
+      paused{false},
+      phase_off{0},
+      pwm_output_num{pwm_pin_number},
+      enable_output_num{enable_pin_number}
+{
+    power.speed_lo = 0;
+    power.speed_hi = speed_max;
+    power.phase_lo = 0;
+    power.phase_hi = 1;
+    power.set_k_value(1);
+}
+
+void LaserToolHead::init()
+{
+    set_pwm_output(pwm_output_num);
+    set_enable_output(enable_output_num);
+    set_pwm_value(phase_off);
+}
+
+void LaserToolHead::pause() {
+    paused = true;
+    set_pwm_value(phase_off);
+}
+
+void LaserToolHead::resume() {
+    // the power comes back with the next segment
+    paused = false;
+}
+
+bool LaserToolHead::ready_to_resume() { return paused && safety_manager->ok_to_spindle(); }
+
+void LaserToolHead::stop() {
+    paused = false;
+    speed = 0;
+    direction = SPINDLE_OFF;
+    set_pwm_value(phase_off);
+    if (enable_output != nullptr) {
+        enable_output->setValue(false);
+    }
+}
+
+// called from a command queued for M3/M4/M5 - there's no motion, so the laser is off
+void LaserToolHead::engage(const GCodeState_t &gm) {
+    speed = gm.spindle_speed;
+    direction = gm.spindle_direction;
+    set_pwm_value(phase_off);
+    if (enable_output != nullptr) {
+        enable_output->setValue(direction != SPINDLE_OFF);
+    }
+}
+
+// called from the loader right before each segment of a move
+void LaserToolHead::engage_segment(float new_speed, float velocity_factor) {
+    speed = new_speed;
+    if (paused || (direction == SPINDLE_OFF) || fp_ZERO(speed) || fp_ZERO(velocity_factor)) {
+        set_pwm_value(phase_off);
+        return;
+    }
+    set_pwm_value(power.speed_to_phase(speed * velocity_factor));
+}
+
+void LaserToolHead::motion_stopped() { set_pwm_value(phase_off); }
+
+// LaserToolHead-specific functions
+bool LaserToolHead::set_pwm_output(const uint8_t pwm_pin_number) {
+    if (pwm_pin_number == 0) {
+        pwm_output = nullptr;
+        return false;
+    }
+
+    pwm_output = d_out[pwm_pin_number - 1];
+    pwm_output->setEnabled(IO_ENABLED);
+    return true;
+}
+uint8_t LaserToolHead::get_pwm_output() {
+    if (pwm_output) {
+        return pwm_output->getExternalNumber();
+    }
+    return 0;
+}
+bool LaserToolHead::set_pwm_polarity(const ioPolarity new_polarity) {
+    if (pwm_output) {
+        pwm_output->setPolarity(new_polarity);
+        return true;
+    }
+    return false;
+}
+ioPolarity LaserToolHead::get_pwm_polarity() {
+    if (pwm_output) {
+        return pwm_output->getPolarity();
+    }
+    return IO_ACTIVE_HIGH;
+}
+
+bool LaserToolHead::set_enable_output(const uint8_t enable_pin_number) {
+    if (enable_pin_number == 0) {
+        enable_output = nullptr;
+        return false;
+    }
+    enable_output = d_out[enable_pin_number - 1];
+    enable_output->setEnabled(IO_ENABLED);
+    return true;
+}
+uint8_t LaserToolHead::get_enable_output() {
+    if (enable_output) {
+        return enable_output->getExternalNumber();
+    }
+    return 0;
+}
+bool LaserToolHead::set_enable_polarity(const ioPolarity new_polarity) {
+    if (enable_output) {
+        enable_output->setPolarity(new_polarity);
+        return true;
+    }
+    return false;
+}
+ioPolarity LaserToolHead::get_enable_polarity() {
+    if (enable_output) {
+        return enable_output->getPolarity();
+    }
+    return IO_ACTIVE_HIGH;
+}
+
+void LaserToolHead::set_frequency(float new_frequency)
+{
+    if (pwm_output) {
+        pwm_output->setFrequency(new_frequency);
+    }
+}
+float LaserToolHead::get_frequency()
+{
+    if (pwm_output) {
+        return pwm_output->getFrequency();
+    }
+    return 0.0;
+}
+
+#endif  // End of include guard: LASER_TOOLHEAD_H_ONCE
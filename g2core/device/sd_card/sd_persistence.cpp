@@ -107,6 +107,7 @@ class SD_Persistence : public Persistence {
    public:
     void init() override;
     stat_t read(nvObj_t *nv) override;
+    stat_t read_all(nvObj_t *nv, fptrRestore restore) override;
     stat_t write(nvObj_t *nv) override;
     stat_t periodic() override;
 };
@@ -126,6 +127,30 @@ void SD_Persistence::init()
     return;
 }
 
+/*
+ * _decode_value() - load nv with the NVM value at src, typed according to cfgArray
+ */
+
+static void _decode_value(nvObj_t *nv, const uint8_t *src)
+{
+    auto type = cfgArray[nv->index].flags & F_TYPE_MASK;
+    if ((type == TYPE_INTEGER) || (type == TYPE_DATA)) {
+        nv->valuetype = TYPE_INTEGER;
+        memcpy(&nv->value_int, src, NVM_VALUE_LEN);
+        DEBUG_PRINT("value (i) copied from address %li in file: %li\n", nv->index * NVM_VALUE_LEN, nv->value_int);
+    } else if (type == TYPE_BOOLEAN) {
+        nv->valuetype = TYPE_BOOLEAN;
+        memcpy(&nv->value_int, src, NVM_VALUE_LEN);
+        DEBUG_PRINT("value (b) copied from address %li in file: %li\n", nv->index * NVM_VALUE_LEN, nv->value_int);
+    } else {
+        float value_flt;
+        memcpy(&value_flt, src, NVM_VALUE_LEN);
+        nv->valuetype = TYPE_FLOAT;
+        nv->value_flt = value_flt;
+        DEBUG_PRINT("value (f) copied from address %li in file: %f\n", nv->index * NVM_VALUE_LEN, nv->value_flt);
+    }
+}
+
 /*
  * read_persistent_value()	- return value (as float) by index
  *
@@ -143,21 +168,45 @@ stat_t SD_Persistence::read(nvObj_t *nv)
         return (STAT_PERSISTENCE_ERROR);
     }
 
-    auto type = cfgArray[nv->index].flags & F_TYPE_MASK;
-    if ((type == TYPE_INTEGER) || (type == TYPE_DATA)) {
-        nv->valuetype = TYPE_INTEGER;
-        nv->value_int = *(int32_t *)nvm.io_buffer;
-        DEBUG_PRINT("value (i) copied from address %li in file: %li\n", nv->index * NVM_VALUE_LEN, nv->value_int);
-    } else if (type == TYPE_BOOLEAN) {
-        nv->valuetype = TYPE_BOOLEAN;
-        nv->value_int = *(int32_t *)nvm.io_buffer;
-        DEBUG_PRINT("value (b) copied from address %li in file: %li\n", nv->index * NVM_VALUE_LEN, nv->value_int);
-    } else {
-        nv->valuetype = TYPE_FLOAT;
-        nv->value_flt = *(float *)nvm.io_buffer;
-        DEBUG_PRINT("value (f) copied from address %li in file: %f\n", nv->index * NVM_VALUE_LEN, nv->value_flt);
-    }
+    _decode_value(nv, nvm.io_buffer);
+    return (STAT_OK);
+}
 
+/*
+ * read_all() - restore all initialized values from a single pass over the file
+ *
+ *  prepare_persistence_file() opens the file and checks the CRC once, then the file is
+ *  read front to back in IO_BUFFER_SIZE chunks and every F_INITIALIZE value in the chunk
+ *  is handed to restore(). This replaces a seek + 4 byte read per item at startup.
+ *
+ *  restore() must not use the persistence file (it's mid-read). nv_set() and nv_persist()
+ *  are safe since writes are deferred to periodic().
+ */
+
+stat_t SD_Persistence::read_all(nvObj_t *nv, fptrRestore restore)
+{
+    ritorno(prepare_persistence_file());
+    fs_ritorno(f_lseek(&nvm.file, 0), "f_lseek during bulk read");
+    DEBUG_PRINT("file opened for bulk reading\n");
+
+    uint16_t step = IO_BUFFER_SIZE/NVM_VALUE_LEN;
+
+    for (index_t cnt = 0; nv_index_is_single(cnt); cnt += step) {
+        UINT io_byte_count = std::min((index_t)IO_BUFFER_SIZE, (nv_index_max()-cnt) * NVM_VALUE_LEN);
+        UINT br;
+        fs_ritorno(f_read(&nvm.file, &nvm.io_buffer, io_byte_count, &br), "bulk read");
+        if (br != io_byte_count) {
+            return (STAT_PERSISTENCE_ERROR);
+        }
+
+        for (nv->index = cnt; (nv->index < cnt + step) && nv_index_is_single(nv->index); nv->index++) {
+            if (GET_TABLE_BYTE(flags) & F_INITIALIZE) {
+                strncpy(nv->token, cfgArray[nv->index].token, TOKEN_LEN);
+                _decode_value(nv, nvm.io_buffer + (nv->index - cnt) * NVM_VALUE_LEN);
+                restore(nv);
+            }
+        }
+    }
     return (STAT_OK);
 }
 
@@ -0,0 +1,241 @@
+/*
+ * spi_scheduler/spi_scheduler.h - priority scheduling of devices sharing an SPI bus
+ * This file is part of the G2 project
+ *
+ * Copyright (c) 2019 Alden S. Hart, Jr.
+ * Copyright (c) 2019 Robert Giseburt
+ *
+ * This file ("the software") is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License, version 2 as
+ * published by the Free Software Foundation. You should have received a copy of
+ * the GNU General Public License, version 2 along with the software.  If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, you may use this file as part of a software library
+ * without restriction. Specifically, if other files instantiate templates or
+ * use macros or inline functions from this file, or you compile this file and
+ * link it with  other files to produce an executable, this file does not by
+ * itself cause the resulting executable to be covered by the GNU General Public
+ * License. This exception does not however invalidate any other reasons why the
+ * executable file might be covered by the GNU General Public License.
+ *
+ * THE SOFTWARE IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL, BUT WITHOUT
+ * ANY WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO
+ * THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR
+ * THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef spi_scheduler_h
+#define spi_scheduler_h
+
+#include "MotateSPI.h"
+
+using Motate::SPIMessage;
+
+enum SPIPriority : uint8_t {
+    kSPIPriorityMotion = 0,     // stepper driver registers
+    kSPIPriorityThermal,        // temperature sensors
+    kSPIPriorityDiagnostic,     // everything else
+    kSPIPriorities
+};
+
+// SPIScheduler - decides which device gets the bus next.
+// Like the I2C_Multiplexer this acts like a bus: devices are made with getDevice()
+// on one of its priority "buses" and queue their messages as normal. The scheduler
+// holds them back and hands the bus one message at a time - the highest priority
+// waiting device first, oldest first within a priority. The next message is sent
+// from the completion callback of the last one, so a queue drains back-to-back
+// without the main loop being involved.
+//
+// A message set up with KeepTransaction keeps the bus for its device - nothing
+// else is sent until that device sends a message that ends the transaction
+// (that's how the TMC2130 clocks out the response to a register read). The
+// device has to queue that message from its callback, or the hold is dropped.
+//
+// Devices must set their message_done_callback before they first queue the message
+// and not change it after - the scheduler wraps it to learn when the bus is free.
+// Like the drivers using it, a device has at most one message queued at a time.
+template <typename SPIBus_t>
+class SPIScheduler final {
+    using scheduler_t = SPIScheduler<SPIBus_t>;
+    using device_t = typename SPIBus_t::SPIBusDevice;
+
+   public:
+    struct SPIScheduledDevice;
+
+    // Counters for one priority, for judging how busy the bus is
+    struct Stats {
+        uint32_t messages;      // messages sent
+        uint32_t waited_max;    // most messages sent ahead of one while it waited
+        uint8_t queued_max;     // most messages waiting at once
+    };
+
+   private:
+    struct PriorityBus;
+
+    // The head and tail of each priority's queue, and the device on the bus
+    SPIScheduledDevice *first_[kSPIPriorities] = {};
+    SPIScheduledDevice *last_[kSPIPriorities] = {};
+    uint8_t queued_[kSPIPriorities] = {};
+    SPIScheduledDevice *sending_ = nullptr;
+    SPIScheduledDevice *holding_ = nullptr;     // device with an open transaction
+    uint32_t sent_ = 0;                         // message sequence, for the wait counter
+
+    Stats stats_[kSPIPriorities] = {};
+
+    // Queue a message for sending - called from the device
+    void queueMessage_(SPIScheduledDevice *device, SPIMessage *msg) {
+        const SPIPriority p = device->priority_;
+        __disable_irq();
+        device->message_ = msg;
+        if (!device->queued_) {
+            device->queued_ = true;
+            device->queued_at_ = sent_;
+            device->next_ = nullptr;
+            if (last_[p]) { last_[p]->next_ = device; } else { first_[p] = device; }
+            last_[p] = device;
+            if (++queued_[p] > stats_[p].queued_max) { stats_[p].queued_max = queued_[p]; }
+        }
+        __enable_irq();
+        sendNext_();
+    }
+
+    // Remove a device from its queue - IRQs must be disabled
+    void unlink_(SPIScheduledDevice *device) {
+        const SPIPriority p = device->priority_;
+        SPIScheduledDevice *prev = nullptr;
+        for (SPIScheduledDevice *d = first_[p]; d != device; d = d->next_) { prev = d; }
+        if (prev) { prev->next_ = device->next_; } else { first_[p] = device->next_; }
+        if (last_[p] == device) { last_[p] = prev; }
+        device->queued_ = false;
+        queued_[p]--;
+    }
+
+    // Send the next message if the bus is free
+    void sendNext_() {
+        __disable_irq();
+        if (sending_) {
+            __enable_irq();
+            return;
+        }
+        SPIScheduledDevice *device = nullptr;
+        if (holding_) {
+            if (holding_->queued_) { device = holding_; }
+        } else {
+            for (uint8_t p = 0; p < kSPIPriorities; p++) {
+                if (first_[p]) {
+                    device = first_[p];
+                    break;
+                }
+            }
+        }
+        if (!device) {
+            __enable_irq();
+            return;
+        }
+        unlink_(device);
+        sending_ = device;
+
+        Stats &stats = stats_[device->priority_];
+        const uint32_t waited = sent_ - device->queued_at_;
+        if (waited > stats.waited_max) { stats.waited_max = waited; }
+        stats.messages++;
+        sent_++;
+        SPIMessage *msg = device->message_;
+        __enable_irq();
+
+        device->device_t::queueMessage(msg);
+    }
+
+    // A message is done - pass it to its device's callback, then send the next one.
+    // If the callback queues another message it's considered with everything else waiting.
+    void messageDone_(SPIScheduledDevice *device) {
+        __disable_irq();
+        sending_ = nullptr;
+        holding_ = device->message_->immediate_ends_transaction ? nullptr : device;
+        __enable_irq();
+
+        if (device->done_callback_) { device->done_callback_(); }
+
+        // a holder that didn't queue its next message from the callback would stall the bus
+        __disable_irq();
+        if ((holding_ == device) && !device->queued_ && (sending_ != device)) { holding_ = nullptr; }
+        __enable_irq();
+        sendNext_();
+    }
+
+    // Devices are made on one of these, which picks their priority
+    struct PriorityBus {
+        scheduler_t *const scheduler_;
+        const SPIPriority priority_;
+
+        template <typename... args_t>
+        SPIScheduledDevice getDevice(args_t&&... args) {
+            return {scheduler_, priority_, scheduler_->spi_bus_->getDevice(std::forward<args_t>(args)...)};
+        }
+    };
+
+    SPIBus_t *const spi_bus_;
+    PriorityBus buses_[kSPIPriorities];
+
+   public:
+    // constexpr so it's set up before the other globals use it to make their devices
+    constexpr SPIScheduler(SPIBus_t &spi_bus)
+        : spi_bus_{&spi_bus},
+          buses_{{this, kSPIPriorityMotion}, {this, kSPIPriorityThermal}, {this, kSPIPriorityDiagnostic}} {}
+
+    // Prevent copying, and prevent moving
+    SPIScheduler(const SPIScheduler &) = delete;
+    SPIScheduler(SPIScheduler &&) = delete;
+
+    // The bus to make devices of the given priority on, in place of the SPIBus
+    PriorityBus &bus(const SPIPriority priority) { return buses_[priority]; }
+
+    // Read (and optionally reset) the counters for a priority
+    Stats getStats(const SPIPriority priority, const bool reset = false) {
+        __disable_irq();
+        Stats stats = stats_[priority];
+        if (reset) { stats_[priority] = {}; }
+        __enable_irq();
+        return stats;
+    }
+
+#pragma mark SPIScheduledDevice (inside SPIScheduler)
+
+    struct SPIScheduledDevice : device_t {
+        scheduler_t *const scheduler_;
+        const SPIPriority priority_;
+
+        SPIScheduledDevice *next_ = nullptr;    // next device in the priority's queue
+        SPIMessage *message_ = nullptr;         // message queued or being sent
+        SPIMessage *wrapped_ = nullptr;         // message whose callback we've wrapped
+        std::function<void()> done_callback_;   // the device's own callback for that message
+        bool queued_ = false;
+        uint32_t queued_at_ = 0;
+
+        SPIScheduledDevice(scheduler_t *const scheduler, const SPIPriority priority, device_t &&device)
+            : device_t{std::move(device)}, scheduler_{scheduler}, priority_{priority} {}
+
+        // prevent copying, allow the move done when returning from getDevice()
+        SPIScheduledDevice(const SPIScheduledDevice &) = delete;
+        SPIScheduledDevice(SPIScheduledDevice &&other)
+            : device_t{std::move(other)}, scheduler_{other.scheduler_}, priority_{other.priority_} {}
+
+        // queue message
+        void queueMessage(SPIMessage *msg) {
+            if (msg != wrapped_) {
+                wrapped_ = msg;
+                done_callback_ = std::move(msg->message_done_callback);
+                msg->message_done_callback = [&] { scheduler_->messageDone_(this); };
+            }
+            scheduler_->queueMessage_(this, msg);
+        }
+    };
+
+    using Device_t = SPIScheduledDevice;
+};
+
+#endif  // spi_scheduler_h
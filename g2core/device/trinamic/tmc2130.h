@@ -112,6 +112,10 @@ struct Trinamic2130 final : Stepper {
     // Timer to keep track of when we need to do another periodic update
     Motate::Timeout check_timer;
 
+    // Stall detection - see _postReadDriverStatus()
+    uint8_t _stall_input = 0;               // virtual input number for stalls, 0 for none
+    bool _stalled = false;
+
     // Constructor - this is the only time we directly use the SBIBus
     template <typename SPIBus_t, typename chipSelect_t>
     Trinamic2130(SPIBus_t &spi_bus, const chipSelect_t &_cs) :
@@ -543,8 +547,18 @@ struct Trinamic2130 final : Stepper {
             uint32_t stst         : 1; // 31
         }  __attribute__ ((packed));
     } DRV_STATUS; // 0x6F- READ ONLY
+    // stallGuard is only measured when moving faster than TCOOLTHRS in spreadCycle, and the
+    // stall flag is meaningless at standstill, so only those stalls are passed on. They go to
+    // the INPUT_ACTION_INTERNAL handlers (homing and probing) as edges on the stall input.
     void _postReadDriverStatus() {
         DRV_STATUS.value = fromBigEndian(in_buffer.value);
+
+        bool stalled = DRV_STATUS.stallGuard && !DRV_STATUS.stst;
+        if ((_stall_input != 0) && (stalled != _stalled)) {
+            _stalled = stalled;
+            din_edge_ticks = st_get_dda_ticks();
+            din_handlers[INPUT_ACTION_INTERNAL].call(stalled, stalled ? INPUT_EDGE_LEADING : INPUT_EDGE_TRAILING, _stall_input);
+        }
     };
     volatile bool DRV_STATUS_needs_read;
 
@@ -567,8 +581,14 @@ struct Trinamic2130 final : Stepper {
 
     void _startNextReadWrite()
     {
-        if (_transmitting || !_inited) { return; }
-        _transmitting = true; // preemptively say we're transmitting .. as a mutex
+        // this is called from the main loop, SysTick and the SPI interrupt, so test-and-set
+        __disable_irq();
+        bool busy = _transmitting || !_inited;
+        if (!busy) {
+            _transmitting = true; // preemptively say we're transmitting .. as a mutex
+        }
+        __enable_irq();
+        if (busy) { return; }
 
         // We request the next register, or re-request that we're reading (and already requested) in order to get the response.
         int16_t next_reg;
@@ -613,8 +633,12 @@ struct Trinamic2130 final : Stepper {
             return;
         }
 
+        // a read request keeps the transaction, so the next message on the bus is ours to clock in the response
+        const bool read_request = !_reading_only && ((next_reg & 0x80) == 0);
+
         out_buffer.addr = (uint8_t) next_reg;
-        _message.setup((uint8_t *)&out_buffer, (uint8_t *)&in_buffer, 5, SPIMessage::DeassertAfter, SPIMessage::KeepTransaction);
+        _message.setup((uint8_t *)&out_buffer, (uint8_t *)&in_buffer, 5, SPIMessage::DeassertAfter,
+                       read_request ? SPIMessage::KeepTransaction : SPIMessage::EndTransaction);
         _device.queueMessage(&_message);
     };
 
@@ -644,9 +668,6 @@ struct Trinamic2130 final : Stepper {
         // in the response
         if (!_reading_only && (out_buffer.addr & 0x80) == 0) {
             _register_thats_reading = out_buffer.addr;
-        } else {
-            // we're not waiting for a read, let another device have a transaction
-            _message.immediate_ends_transaction = true;
         }
         _reading_only = false;
 
@@ -785,12 +806,23 @@ struct Trinamic2130 final : Stepper {
             check_timer.set(100);
             IOIN_needs_read = true;
             CHOPCONF_needs_read = true;
-            DRV_STATUS_needs_read = true;
             TSTEP_needs_read = true;
         }
         _startNextReadWrite();
     };
 
+    // DRV_STATUS is read here, at the rate set by the stepper's round-robin of the drivers
+    void requestStatus() override
+    {
+        DRV_STATUS_needs_read = true;
+        _startNextReadWrite();
+    };
+
+    void setStallInput(const uint8_t input_number) override
+    {
+        _stall_input = input_number;
+    };
+
     // helper to create functions that retrieve the object from the cfgArray[...].target
     // and call the correct function of that target
     template <stat_t(type::*T)(nvObj_t *nv)>
@@ -920,6 +952,14 @@ struct Trinamic2130 final : Stepper {
     static stat_t get_sgs_fn(nvObj_t *nv) { return get_fn<&type::get_sgs>(nv); };
     // no set
 
+    stat_t get_ot(nvObj_t *nv) {
+        nv->value_int = DRV_STATUS.ot ? 2 : (DRV_STATUS.otpw ? 1 : 0);  // 0=ok, 1=prewarning, 2=shutdown
+        nv->valuetype = TYPE_INTEGER;
+        return STAT_OK;
+    };
+    static stat_t get_ot_fn(nvObj_t *nv) { return get_fn<&type::get_ot>(nv); };
+    // no set
+
 
     stat_t get_tbl(nvObj_t *nv) {
         nv->value_int = CHOPCONF.TBL;
@@ -28,11 +28,14 @@
 #include "g2core.h"
 #include "config.h"
 #include "encoder.h"
+#include "stepper.h"            // for ExternalEncoder and motor configs
+#include "util.h"
 #include "canonical_machine.h"  // needed for cm_panic() in assertions
 
 /**** Allocate Structures ****/
 
 enEncoders_t en;
+static enExternal_t en_ext[MOTORS];     // not in en, as boards attach before encoder_init() clears it
 
 /************************************************************************************
  **** CODE **************************************************************************
@@ -98,36 +101,144 @@ float en_read_encoder(uint8_t motor) { return ((float)en.en[motor].encoder_steps
  *  presumably in the middle of a switch closure interrupt. Taking the snapshot
  *  does not affect the normal accumulation run by the stepper DDA.
  *
+ *  edge_ticks is the DDA tick count when the switch changed, as timestamped by the input
+ *  interrupt (din_edge_ticks). The motors have kept stepping while the input was dispatched,
+ *  so the position now is moved back along each motor's step rate to that tick. The DDA's
+ *  substep phase is included for motors that are stepping, so the result is to a fraction of
+ *  a step. A stopped motor reads its counted steps, as its phase doesn't move. If the DDA ticks
+ *  while this reads it the reads are started over.
+ *
  *  The results are in STEPS, which may need to be converted back to position using
  *  forward kinematics, depending on your use. See probe cycle for example.
  */
-void en_take_encoder_snapshot() {
-    for (uint8_t m = 0; m < MOTORS; m++) { en.snapshot[m] = en.en[m].encoder_steps + en.en[m].steps_run; }
-
-    /* loop unrolled version for faster execution
-        en.snapshot[MOTOR_1] = en.en[MOTOR_1].encoder_steps + en.en[MOTOR_1].steps_run;
-        en.snapshot[MOTOR_2] = en.en[MOTOR_2].encoder_steps + en.en[MOTOR_2].steps_run;
-        en.snapshot[MOTOR_3] = en.en[MOTOR_3].encoder_steps + en.en[MOTOR_3].steps_run;
-        en.snapshot[MOTOR_4] = en.en[MOTOR_4].encoder_steps + en.en[MOTOR_4].steps_run;
-        en.snapshot[MOTOR_5] = en.en[MOTOR_5].encoder_steps + en.en[MOTOR_5].steps_run;
-        en.snapshot[MOTOR_6] = en.en[MOTOR_6].encoder_steps + en.en[MOTOR_6].steps_run;
-    */
+void en_take_encoder_snapshot(const uint32_t edge_ticks) {
+    uint32_t ticks;
+    do {
+        ticks = st_get_dda_ticks();
+        uint32_t latency = ticks - edge_ticks;
+        if (latency > SNAPSHOT_LATENCY_MAX) {
+            latency = 0;
+        }
+        for (uint8_t m = 0; m < MOTORS; m++) {
+            float substeps = 0;
+            float step_rate = st_get_step_rate(m);
+            if (fp_NOT_ZERO(step_rate)) {           // a stopped motor's phase is left over from its last move
+                substeps = st_get_substep_phase(m) - (step_rate * latency);
+            }
+            en.snapshot[m] = en.en[m].encoder_steps + en.en[m].steps_run + (en.en[m].step_sign * substeps);
+        }
+    } while (ticks != st_get_dda_ticks());
 }
 
 float en_get_encoder_snapshot_steps(uint8_t motor) { return (en.snapshot[motor]); }
 
 float* en_get_encoder_snapshot_vector() { return (en.snapshot); }
 
-/***********************************************************************************
- * CONFIGURATION AND INTERFACE FUNCTIONS
- * Functions to get and set variables from the cfgArray table
- ***********************************************************************************/
+/*
+ * en_attach_external_encoder() - use an external encoder for this motor's following error
+ * en_has_external_encoder()    - true if the motor has an external encoder
+ * en_sync_external_encoders()  - re-zero all external encoders to the step count
+ *
+ *  Boards call en_attach_external_encoder() from their init (gQuintic does when it's built with
+ *  HAS_EXTERNAL_ENCODERS). revs_per_motor_rev is 1.0 for an encoder on the motor shaft, -1.0 if
+ *  it counts the other way.
+ *
+ *  Syncing happens on the first reading taken with the motor standing still, so calling
+ *  en_sync_external_encoders() is safe at any time, and must be done whenever the step count
+ *  is set (see mp_set_steps_to_runtime_position()).
+ */
+
+static float _counted_steps(uint8_t motor)      // includes the steps of the running segment
+{
+    return ((float)(en.en[motor].encoder_steps + en.en[motor].steps_run));
+}
+
+void en_attach_external_encoder(uint8_t motor, ExternalEncoder *encoder, float revs_per_motor_rev)
+{
+    enExternal_t *ex = &en_ext[motor];
+    ex->revs_per_motor_rev = revs_per_motor_rev;
+    ex->synced = false;
+    ex->reading_pending = false;
+    ex->reading_ready = false;
+    ex->encoder = encoder;
+    encoder->setCallback([ex, motor](bool worked, float fraction) {    // runs at interrupt level
+        ex->reply_steps = _counted_steps(motor);
+        ex->reading = fraction;
+        ex->reading_worked = worked;
+        ex->reading_ready = true;
+    });
+}
 
-/***********************************************************************************
- * TEXT MODE SUPPORT
- * Functions to print variables from the cfgArray table
- ***********************************************************************************/
+bool en_has_external_encoder(uint8_t motor) { return (en_ext[motor].encoder != nullptr); }
 
-#ifdef __TEXT_MODE
+void en_sync_external_encoders()
+{
+    for (uint8_t m = 0; m < MOTORS; m++) {
+        en_ext[m].synced = false;
+        en_ext[m].missed_steps = 0;
+        en_ext[m].request_steps = NAN;      // a reading in flight straddles the change - don't sync to it
+    }
+}
 
-#endif  // __TEXT_MODE
+/*
+ * en_following_error() - return the following error to correct for this motor, in steps
+ *
+ *  Called from prep for each segment. step_error is the step counting (virtual encoder) error,
+ *  which is returned as-is for motors without an external encoder. Otherwise the missed steps
+ *  are added to it: corrections show up in step_error as they are made, so between the two
+ *  the error is back to zero once the missed steps have been made up.
+ *
+ *  Each call processes the reading that came back since the last one (if any) and requests
+ *  the next.
+ */
+
+float en_following_error(uint8_t motor, float step_error)
+{
+    enExternal_t *ex = &en_ext[motor];
+    if (ex->encoder == nullptr) {
+        return (step_error);
+    }
+    if (ex->reading_pending && !ex->reading_ready) {    // still waiting
+        return (step_error + ex->missed_steps);
+    }
+
+    if (ex->reading_ready && ex->reading_worked) {
+        // unwrap - assumes the encoder can't turn more than half a revolution between readings
+        double diff = ex->reading - (ex->revolutions - std::floor(ex->revolutions));
+        if (diff < -0.5) {
+            diff += 1.0;
+        } else if (diff > 0.5) {
+            diff -= 1.0;
+        }
+        ex->revolutions += diff;
+
+        float steps_per_rev = (360 / st_cfg.mot[motor].step_angle) * st_cfg.mot[motor].microsteps;
+        float measured = (ex->revolutions / ex->revs_per_motor_rev) * steps_per_rev;
+        float lo = std::min(ex->request_steps, (float)ex->reply_steps);
+        float hi = std::max(ex->request_steps, (float)ex->reply_steps);
+
+        if (!ex->synced) {
+            if (fp_EQ(ex->request_steps, ex->reply_steps)) {   // only sync to a reading taken standing still
+                ex->offset = ex->request_steps - measured;
+                ex->missed_steps = 0;
+                ex->synced = true;
+            }
+        } else {
+            measured += ex->offset;
+            float missed = 0;
+            if (measured < lo) {
+                missed = measured - lo;
+            } else if (measured > hi) {
+                missed = measured - hi;
+            }
+            ex->missed_steps += (missed - ex->missed_steps) * EXTERNAL_ENCODER_FILTER;
+        }
+    }
+
+    ex->reading_ready = false;                          // request the next reading
+    ex->reading_pending = true;
+    ex->request_steps = _counted_steps(motor);
+    ex->encoder->requestAngleFraction();
+
+    return (step_error + ex->missed_steps);
+}
@@ -93,6 +93,25 @@
 
 /**** Configs and Constants ****/
 
+/* External encoder following error
+ *
+ *  Motors can have an external (measuring) encoder attached by the board, which catches the
+ *  steps the motor misses - something counting steps can't see. Readings are requested at prep
+ *  time and come back asynchronously (e.g. over I2C) while the segment runs, so each reading is
+ *  checked against the steps counted between the request and the reply. Only the distance outside
+ *  that range counts as missed steps, which are low-passed and added to the following error that
+ *  st_prep_line() corrects.
+ */
+#define EXTERNAL_ENCODER_FILTER     (float)0.30     // weight of a new error reading in the low pass (0-1)
+
+/* Snapshot latency
+ *
+ *  Snapshots are taken in an input handler some time after the input's edge, and are
+ *  extrapolated back to the DDA tick the edge was timestamped at. An edge more than
+ *  SNAPSHOT_LATENCY_MAX old is assumed to be unrelated, and the position is taken as it is now.
+ */
+#define SNAPSHOT_LATENCY_MAX        (FREQUENCY_DDA / 1000)  // DDA ticks - 1 ms
+
 /**** Macros ****/
 // used to abstract the encoder code out of the stepper so it can be managed in one place
 
@@ -104,6 +123,25 @@
 
 /**** Structures ****/
 
+class ExternalEncoder;                  // see stepper.h
+
+typedef struct enExternal {             // external encoder state for one motor
+    ExternalEncoder *encoder;           // nullptr if the motor has no external encoder
+    float revs_per_motor_rev;           // encoder revolutions per motor revolution (signed for direction)
+
+    volatile bool reading_pending;      // a reading has been requested...
+    volatile bool reading_ready;        // ...and has come back (set from the encoder callback)
+    volatile bool reading_worked;
+    volatile float reading;             // 0.0 <= reading < 1.0 revolutions
+    float request_steps;                // steps counted when the reading was requested...
+    volatile float reply_steps;         // ...and when it came back
+
+    double revolutions;                 // unwrapped encoder position
+    bool synced;                        // offset is valid
+    float offset;                       // steps from measured to counted position, set at sync
+    float missed_steps;                 // low-passed, + for ahead of the step count
+} enExternal_t;
+
 typedef struct enEncoder {          // one real or virtual encoder per controlled motor
     int8_t  step_sign;              // set to +1 or -1
     int16_t steps_run;              // + or - steps counted during stepper interrupt
@@ -130,8 +168,13 @@ stat_t encoder_test_assertions(void);
 void en_set_encoder_steps(uint8_t motor, float steps);
 float en_read_encoder(uint8_t motor);
 
-void en_take_encoder_snapshot();
+void en_take_encoder_snapshot(const uint32_t edge_ticks);
 float en_get_encoder_snapshot_steps(uint8_t motor);
 float* en_get_encoder_snapshot_vector();
 
+void en_attach_external_encoder(uint8_t motor, ExternalEncoder *encoder, float revs_per_motor_rev);
+bool en_has_external_encoder(uint8_t motor);
+void en_sync_external_encoders(void);
+float en_following_error(uint8_t motor, float step_error);
+
 #endif  // End of include guard: ENCODER_H_ONCE
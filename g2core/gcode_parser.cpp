@@ -80,6 +80,7 @@ typedef enum {                                  // these are in order to optimiz
     NEXT_ACTION_STRAIGHT_PROBE,                 // G38.3
     NEXT_ACTION_STRAIGHT_PROBE_AWAY_ERR,        // G38.4
     NEXT_ACTION_STRAIGHT_PROBE_AWAY,            // G38.5
+    NEXT_ACTION_PROBE_GRID,                     // G29.1 height map probe
     NEXT_ACTION_SET_TL_OFFSET,                  // G43
     NEXT_ACTION_SET_ADDITIONAL_TL_OFFSET,       // G43.2
     NEXT_ACTION_CANCEL_TL_OFFSET,               // G49
@@ -106,6 +107,7 @@ typedef enum {                                  // these are in order to optimiz
     NEXT_ACTION_MARLIN_REPORT_VERSION,          // M115
     NEXT_ACTION_MARLIN_DISPLAY_ON_SCREEN,       // M117
     NEXT_ACTION_MARLIN_SET_BED_TEMP,            // M140, M190
+    NEXT_ACTION_MARLIN_AUTOTUNE_PID,            // M303
     NEXT_ACTION_MARLIN_SET_JERK,                // M205
 #endif
 
@@ -700,9 +702,16 @@ static stat_t _parse_gcode_block(char *buf, char *active_comment)
                     }
                     break;
                 }
+                case 29: {
+                    switch (_point(value)) {
 #if MARLIN_COMPAT_ENABLED == true
-                case 29: SET_NON_MODAL (next_action, NEXT_ACTION_MARLIN_TRAM_BED);
+                        case 0: SET_NON_MODAL (next_action, NEXT_ACTION_MARLIN_TRAM_BED);
 #endif
+                        case 1: SET_NON_MODAL (next_action, NEXT_ACTION_PROBE_GRID);
+                        default: status = STAT_GCODE_COMMAND_UNSUPPORTED;
+                    }
+                    break;
+                }
                 case 30: {
                     switch (_point(value)) {
                         case 0: SET_MODAL (MODAL_GROUP_G0, next_action, NEXT_ACTION_GOTO_G30_POSITION);
@@ -846,6 +855,7 @@ static stat_t _parse_gcode_block(char *buf, char *active_comment)
                 case 117: status = STAT_COMPLETE; break;  //SET_NON_MODAL (next_action, NEXT_ACTION_MARLIN_DISPLAY_ON_SCREEN);
 
                 case 205: SET_NON_MODAL (next_action, NEXT_ACTION_MARLIN_SET_JERK);         // set jerk
+                case 303: SET_NON_MODAL (next_action, NEXT_ACTION_MARLIN_AUTOTUNE_PID);     // autotune heater PID
 #endif // MARLIN_COMPAT_ENABLED
 
                 default: status = STAT_MCODE_COMMAND_UNSUPPORTED;
@@ -1021,6 +1031,10 @@ stat_t _execute_gcode_block(char *active_comment)
         case NEXT_ACTION_STRAIGHT_PROBE:         { status = cm_straight_probe(gv.target, gf.target, true, false); break;} // G38.3
         case NEXT_ACTION_STRAIGHT_PROBE_AWAY_ERR:{ status = cm_straight_probe(gv.target, gf.target, false, true); break;} // G38.4
         case NEXT_ACTION_STRAIGHT_PROBE_AWAY:    { status = cm_straight_probe(gv.target, gf.target, false, false); break;}// G38.5
+        case NEXT_ACTION_PROBE_GRID:             { status = cm_probe_grid(gv.target, gf.target,                 // G29.1
+                                                                          gv.arc_offset, gf.arc_offset,
+                                                                          gv.P_word, gf.P_word,
+                                                                          gv.L_word, gf.L_word); break;}
 
         case NEXT_ACTION_SET_G10_DATA:           { status = cm_set_g10_data(gv.P_word, gf.P_word,               // G10
                                                                             gv.L_word, gf.L_word,
@@ -1117,7 +1131,7 @@ static stat_t _execute_gcode_block_marlin()
     if (gf.marlin_relative_extruder_mode) {                 // M82, M83
         marlin_set_extruder_mode(gv.marlin_relative_extruder_mode);
     }
-    if (gf.E_word) {
+    if (gf.E_word && (gv.next_action != NEXT_ACTION_MARLIN_AUTOTUNE_PID)) {    // M303 E is the heater
         // Ennn T0 -> Annn
         if (cm->gm.tool_select == 1) {
             gf.target[AXIS_A] = true;
@@ -1164,6 +1178,17 @@ static stat_t _execute_gcode_block_marlin()
             gf.S_word = false;
             break;
         }
+        case NEXT_ACTION_MARLIN_AUTOTUNE_PID:   {           // M303 E<heater> S<temperature> C<cycles>
+            mst.marlin_flavor = true;                       // these gcodes are ONLY in marlin flavor
+            ritorno(marlin_autotune_heater(gf.E_word ? gv.E_word : 0,
+                                           gf.S_word ? gv.S_word : 150,
+                                           gf.target[AXIS_C] ? gv.target[AXIS_C] : 0));
+            gf.E_word = false;
+            gf.S_word = false;
+            gf.target[AXIS_C] = false;                      // C is the cycle count, and U (use the result) is implied
+            gf.target[AXIS_U] = false;
+            break;
+        }
         case NEXT_ACTION_MARLIN_CANCEL_WAIT_TEMP:   {       // M108
             js.json_mode = MARLIN_COMM_MODE;                // we use M105 to know when to switch
             cm_request_feedhold(FEEDHOLD_TYPE_HOLD, FEEDHOLD_EXIT_STOP);
@@ -97,15 +97,15 @@ void gpio_reset(void)
 
 bool gpio_read_input(const uint8_t input_num)
 {
-    if (input_num == 0) {
-        return false;
+    if ((input_num == 0) || (input_num > D_IN_CHANNELS)) {  // past D_IN_CHANNELS are stall inputs, which
+        return false;                                       // are only ever active while moving
     }
     return (d_in[input_num-1]->getState());
 }
 
 void gpio_set_input_lockout(const uint8_t input_num, const uint16_t lockout_ms)
 {
-    if (input_num == 0) {
+    if ((input_num == 0) || (input_num > D_IN_CHANNELS)) {
         return;
     }
     d_in[input_num-1]->setLockout(lockout_ms);
@@ -174,6 +174,7 @@ gpioDigitalOutputWriter* const out_w[16] = {&out1, &out2, &out3, &out4, &out5, &
 
 // lists for the various inputAction events
 gpioDigitalInputHandlerList din_handlers[INPUT_ACTION_ACTUAL_MAX+1];
+volatile uint32_t din_edge_ticks;
 
 gpioAnalogInputReader ain1;
 gpioAnalogInputReader ain2;
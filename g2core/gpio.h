@@ -116,8 +116,8 @@ extern gpioDigitalInputReader* const in_r[16];
  * Example gpioDigitalInputHandler object creation:
 
     gpioDigitalInputHandler limitHandler {
-        [&](const bool state, const inputEdgeFlag edge, const uint8_t triggering_pin_number) {
-            if (edge != INPUT_EDGE_LEADING) { return; }
+        [](const bool state, const inputEdgeFlag edge, const uint8_t triggering_pin_number) {
+            if (edge != INPUT_EDGE_LEADING) { return false; }
             limit_requested = true; // record that a limit was requested for later processing
             return false; // allow others to see this notice
         },
@@ -126,27 +126,121 @@ extern gpioDigitalInputReader* const in_r[16];
     };
 
     // register this listener for limit events:
-    din_handlers[INPUT_ACTION_LIMIT].registerHandler(limitHandler);
+    din_handlers[INPUT_ACTION_LIMIT].registerHandler(&limitHandler);
+
+ * The callback is a plain function or a lambda that captures nothing, as only a function pointer
+ * is kept. Objects that handle inputs in a member function pass a bound callback instead:
+
+    gpioDigitalInputCallback::bind<MyClass, &MyClass::handleInput>(this)
  */
 
-enum {
-    GPIO_HANDLED = true,
-    GPIO_NOT_HANDLED = false
+// bools, not an enum, so handler lambdas that return these are bool functions
+const bool GPIO_HANDLED = true;
+const bool GPIO_NOT_HANDLED = false;
+
+/*
+ * gpioDigitalInputCallback - non-owning reference to a handler function
+ *
+ *  A function pointer and the object it's called on. Plain functions (and captureless lambdas)
+ *  are called through _call_function() with the function itself as the context, and member
+ *  functions through bind(), so calling one is a single indirect call with no heap or
+ *  std::function machinery behind it.
+ */
+
+struct gpioDigitalInputCallback {
+    typedef bool (*function_t)(const bool, const inputEdgeFlag, const uint8_t);
+
+    bool (*call)(void * const context, const bool state, const inputEdgeFlag edge, const uint8_t triggering_pin_number);
+    void *context;
+
+    static bool _call_function(void * const context, const bool state, const inputEdgeFlag edge, const uint8_t triggering_pin_number) {
+        return reinterpret_cast<function_t>(context)(state, edge, triggering_pin_number);
+    }
+
+    template <typename T, bool (T::*method)(const bool, const inputEdgeFlag, const uint8_t)>
+    static bool _call_method(void * const context, const bool state, const inputEdgeFlag edge, const uint8_t triggering_pin_number) {
+        return (static_cast<T *>(context)->*method)(state, edge, triggering_pin_number);
+    }
+
+    // bind a member function to an object, like bind<I2C_AS5601, &I2C_AS5601::handleQuadrature>(this)
+    template <typename T, bool (T::*method)(const bool, const inputEdgeFlag, const uint8_t)>
+    static gpioDigitalInputCallback bind(T * const object) {
+        return gpioDigitalInputCallback{_call_method<T, method>, static_cast<void *>(object)};
+    }
 };
 
 struct gpioDigitalInputHandler {
-    // const means it must be provided at compile time
-    const std::function<bool(const bool, const inputEdgeFlag, const uint8_t)> callback;  // the function to call
+    const gpioDigitalInputCallback callback;                  // the function to call
     const int8_t priority;                                    // higher is higher
 
     gpioDigitalInputHandler *next;                           // form a simple linked list
+
+    gpioDigitalInputHandler(const gpioDigitalInputCallback::function_t function, const int8_t priority_, gpioDigitalInputHandler * const next_)
+        : callback{gpioDigitalInputCallback::_call_function, reinterpret_cast<void *>(function)}, priority{priority_}, next{next_} {};
+
+    gpioDigitalInputHandler(const gpioDigitalInputCallback &callback_, const int8_t priority_, gpioDigitalInputHandler * const next_)
+        : callback(callback_), priority{priority_}, next{next_} {};
 };
 
+/*
+ * gpioDigitalInputHandlerList - handlers for one inputAction, in priority order
+ *
+ *  Handlers are kept in a linked list by priority, and each time one is registered or
+ *  deregistered the list is flattened into a table of their callbacks. call() runs from the
+ *  pin interrupts, so it only walks that table. There are two tables and the new one is
+ *  built in the spare and then swapped in with a single write, so an interrupt that
+ *  lands during (de)registration sees either the old or the new set of handlers.
+ *
+ *  GPIO_HANDLERS_MAX is the most handlers one inputAction can have registered at once, and
+ *  registerHandler() fails with an exception report rather than drop one. The lists are
+ *  all-zero (empty) until the first registration, so they work before constructors run.
+ */
+
+#define GPIO_HANDLERS_MAX 8
 
 struct gpioDigitalInputHandlerList {
     gpioDigitalInputHandler * _first_handler;
 
-    void registerHandler(gpioDigitalInputHandler * const new_handler) {
+    gpioDigitalInputCallback _tables[2][GPIO_HANDLERS_MAX+1];  // nullptr call terminated
+    volatile uint8_t _table;                                 // the table call() uses
+
+    void _rebuild() {
+        const uint8_t spare = _table ^ 1;
+        gpioDigitalInputCallback *table = _tables[spare];
+        uint8_t count = 0;
+        for (gpioDigitalInputHandler * current_handler = _first_handler;
+             (current_handler != nullptr) && (count < GPIO_HANDLERS_MAX);
+             current_handler = current_handler->next) {
+            table[count++] = current_handler->callback;
+        }
+        table[count].call = nullptr;
+        _table = spare;
+    };
+
+    // returns STAT_BUFFER_FULL (and reports it) if the handler didn't fit in the table
+    stat_t registerHandler(gpioDigitalInputHandler * const new_handler) {
+        uint8_t count = 0;
+        for (gpioDigitalInputHandler * current_handler = _first_handler; current_handler != nullptr;
+             current_handler = current_handler->next) {
+            if (current_handler == new_handler) {
+                return (STAT_OK);   // it's already registered
+            }
+            count++;
+        }
+        if (count >= GPIO_HANDLERS_MAX) {
+            return (rpt_exception(STAT_BUFFER_FULL, "input handler not registered - GPIO_HANDLERS_MAX exceeded"));
+        }
+        _insertHandler(new_handler);
+        _rebuild();
+        return (STAT_OK);
+    };
+
+    void deregisterHandler(gpioDigitalInputHandler * const old_handler) {
+        _removeHandler(old_handler);
+        _rebuild();
+    };
+
+    void _insertHandler(gpioDigitalInputHandler * const new_handler) {
         if (!_first_handler) {
             // there is only one - now
             _first_handler = new_handler;
@@ -174,7 +268,7 @@ struct gpioDigitalInputHandlerList {
         }
     };
 
-    void deregisterHandler(gpioDigitalInputHandler * const old_handler) {
+    void _removeHandler(gpioDigitalInputHandler * const old_handler) {
         if (!_first_handler) {
             return;
         } else if (_first_handler == old_handler) {
@@ -194,12 +288,10 @@ struct gpioDigitalInputHandlerList {
     };
 
     bool call(const bool state, const inputEdgeFlag edge, const uint8_t triggering_pin_number) {
-        gpioDigitalInputHandler * current_handler = _first_handler;
-        while (current_handler != nullptr) {
-            if (GPIO_HANDLED == current_handler->callback(state, edge, triggering_pin_number)) {
+        for (const gpioDigitalInputCallback *callback = _tables[_table]; callback->call != nullptr; callback++) {
+            if (GPIO_HANDLED == callback->call(callback->context, state, edge, triggering_pin_number)) {
                 return GPIO_HANDLED;
             }
-            current_handler = current_handler->next;
         }
         return GPIO_NOT_HANDLED;
     }
@@ -208,6 +300,12 @@ struct gpioDigitalInputHandlerList {
 // lists for the various inputAction events
 extern gpioDigitalInputHandlerList din_handlers[INPUT_ACTION_ACTUAL_MAX+1];
 
+// DDA tick count when the input being dispatched changed - valid in handlers
+extern volatile uint32_t din_edge_ticks;
+
+// forward declare from stepper.h (which includes this file)
+uint32_t st_get_dda_ticks(void);
+
 /*
  * gpioDigitalInput - digital input base class
  */
@@ -485,6 +583,9 @@ struct gpioDigitalInputPin final : gpioDigitalInput {
 
     void pin_changed()
     {
+        // timestamp the edge first, before anything else delays it
+        const uint32_t edge_ticks = st_get_dda_ticks();
+
         // return if input is disabled
         if (enabled == IO_DISABLED) {
             return;
@@ -516,6 +617,7 @@ struct gpioDigitalInputPin final : gpioDigitalInput {
         }
 
         // start with INPUT_ACTION_INTERNAL for transient event processing like homing and probing
+        din_edge_ticks = edge_ticks;
         if (GPIO_NOT_HANDLED == din_handlers[INPUT_ACTION_INTERNAL].call(pin_value_corrected, edge, ext_pin_number)) {
             din_handlers[action].call(pin_value_corrected, edge, ext_pin_number);
         }
@@ -1052,6 +1154,11 @@ extern gpioAnalogInputReader ain7;
 extern gpioAnalogInputReader ain8;
 
 // statistical sampling utility class
+//
+// add_sample() runs in the ADC interrupt, so it only updates the rolling sums, and value() makes
+// the pass that drops outliers lazily, once per new sample that is actually read. The rolling
+// sum of squares loses the variance to cancellation if rounding is left to build up in it, so
+// the sums are re-added from the samples each time the window wraps.
 template<uint16_t sample_count>
 struct ValueHistory {
 
@@ -1091,6 +1198,16 @@ struct ValueHistory {
         _bump_index(next_sample);
         if (sampled < sample_count) { ++sampled; }
 
+        // re-add the rolling sums once per window so rounding doesn't accumulate in them
+        if (next_sample == 0) {
+            rolling_sum = 0;
+            rolling_sum_sq = 0;
+            for (uint16_t i=0; i<sample_count; i++) {
+                rolling_sum += samples[i].value;
+                rolling_sum_sq += samples[i].value_sq;
+            }
+        }
+
         rolling_mean = rolling_sum/(float)sampled;
     };
 
@@ -1109,11 +1226,12 @@ struct ValueHistory {
         float temp = 0;
         float std_dev = get_std_dev();
 
+        const float limit = variance_max * std_dev;
         for (uint16_t i=0; i<sampled; i++) {
-            if (std::abs(samples[i].value - rolling_mean) < (variance_max * std_dev)) {
-                temp += samples[i].value;
-                ++samples_kept;
-            }
+            // no branch, as whether a sample is kept is unpredictable
+            const bool keep = (std::abs(samples[i].value - rolling_mean) < limit);
+            temp += keep ? samples[i].value : 0;
+            samples_kept += keep;
         }
 
         // fallback position
@@ -44,14 +44,22 @@ jsSingleton_t js;
 
 static stat_t _json_parser_kernal(nvObj_t *nv, char *str);
 static stat_t _json_parser_execute(nvObj_t *nv);
-static stat_t _normalize_json_string(char *str, uint16_t size);
-static stat_t _get_nv_pair(nvObj_t *nv, char **pstr, int8_t *depth);
+typedef struct jsScan {                             // cursor into the raw input string
+    char *rd;                                       // read pointer
+    const char *end;                                // JSON_INPUT_STRING_MAX past the start
+} jsScan_t;
+
+static char _scan_char(jsScan_t *scan);
+static stat_t _get_nv_name(jsScan_t *scan, char *token);
+static stat_t _get_nv_string(nvObj_t *nv, jsScan_t *scan);
+static stat_t _get_nv_terminator(jsScan_t *scan, int8_t *depth);
+static stat_t _get_nv_pair(nvObj_t *nv, jsScan_t *scan, int8_t *depth);
+static stat_t _json_batch_get(char *str);
 
 /****************************************************************************
  * json_parser() - exposed part of JSON parser
  * _json_parser_kernal()
- * _normalize_json_string()
- * _get_nv_pair_strict()
+ * _get_nv_pair()
  *
  *  This is a dumbed down JSON parser to fit in limited memory with no malloc
  *  or practical way to do recursion ("depth" tracks parent/child levels).
@@ -73,6 +81,7 @@ static stat_t _get_nv_pair(nvObj_t *nv, char **pstr, int8_t *depth);
  *    - hexadecimal or other non-decimal number bases are not supported
  *
  *  The parser:
+ *    - tokenizes the raw input in a single pass - whitespace and case are normalized on the fly
  *    - extracts an array of one or more JSON object structs from the input string
  *    - once the array is built it executes the object(s) in order in the array
  *    - passes the executed array to the response handler to generate the response string
@@ -80,13 +89,16 @@ static stat_t _get_nv_pair(nvObj_t *nv, char **pstr, int8_t *depth);
  *
  *  Separation of concerns
  *    json_parser() is the only exposed part. It does parsing, display, and status reports.
- *    _get_nv_pair() only does parsing and syntax; no semantic validation or group handling
+ *    _get_nv_pair() only does tokenizing and syntax; no semantic validation or group handling
  *    _json_parser_kernal() does index validation and group handling
  *    _json_parser_execute() executes sets and gets in an application agnostic way. It should work for other apps than g2core
  */
 
 stat_t json_parser(char *str, bool suppress_response) // suppress_response defaults to false, see decalaration in .h
 {
+    if (!suppress_response && (_json_batch_get(str) == STAT_COMPLETE)) {
+        return (STAT_OK);                           // multi-key GET was streamed directly to the host
+    }
     nvObj_t *nv = nv_reset_nv_list();               // get a fresh nvObj list
     stat_t status = _json_parser_kernal(nv, str);
     if (status == STAT_OK) {                        // execute the command
@@ -141,6 +153,146 @@ static stat_t _json_parser_execute(nvObj_t *nv) {
     return (STAT_OK);                               // only successful commands exit through this point
 }
 
+/*
+ * _json_batch_get()      - stream the response to a flat, multi-key GET
+ * _json_next_batch_key() - scan the next key of a flat GET; helper to _json_batch_get()
+ * _json_batch_serialize() - GET and serialize one key; helper to _json_batch_get()
+ *
+ *  Requests like {"xvm":n,"yvm":n,"zvm":n, ... } are common on host connect and can be
+ *  much longer than the nv list will hold. Rather than build the whole list, each key is
+ *  read into the nv body, run through its GET function, serialized and written to the
+ *  host before the next key is read. The response is a single line identical in form to
+ *  the one json_print_response() would build: {"r":{...},"f":[1,status,count]}
+ *
+ *  Every key is scanned before anything is run. Scanning names and nulls does not write to
+ *  the input string, so any request that is not a pure multi-key GET (sets, nested objects,
+ *  unknown keys, syntax errors) falls through to the regular parser, and gets the regular
+ *  response - including the error footer. The same is true for groups, keys
+ *  json_print_response() filters by echo setting (gc, n, msg...), and verbosity modes that
+ *  may withhold the response based on the final status.
+ *
+ *  Each key is then run and serialized exactly once, into a response buffer that is only
+ *  written to the host when every key is in it, so the values are all from one pass and the
+ *  host never sees a partial response. A GET that fails falls through to the regular parser
+ *  for its error response. A response that doesn't fit the buffer is not sent - the host
+ *  gets an empty response with a STAT_JSON_OUTPUT_TOO_LONG footer instead.
+ *
+ *  Returns STAT_COMPLETE if the response was sent, STAT_NOOP if it fell through.
+ */
+
+static stat_t _json_next_batch_key(jsScan_t *scan, char *key)
+{
+    ritorno(_get_nv_name(scan, key));
+    char c = _scan_char(scan);
+    if (c == '"') {                                 // empty string is also a GET
+        scan->rd++;
+        if (_scan_char(scan) != '"') {
+            return (STAT_JSON_SYNTAX_ERROR);        // a SET
+        }
+        scan->rd++;
+    } else if (c != 'n') {                          // null, accepting relaxed forms as _get_nv_pair() does
+        return (STAT_JSON_SYNTAX_ERROR);            // a SET, or a nested object
+    }
+    int8_t depth = 1;
+    return (_get_nv_terminator(scan, &depth));
+}
+
+static stat_t _json_batch_serialize(const char *key, uint16_t *len)
+{
+    nv_reset_nv_list();
+    nvObj_t *nv = nv_body;
+    strcpy(nv->token, key);
+    nv->index = nv_get_index((const char *)"", key);
+    nv->valuetype = TYPE_NULL;
+    ritorno(nv_get(nv));
+    *len = json_serialize(nv_body, cs.out_buf, sizeof(cs.out_buf));
+    if (*len >= sizeof(cs.out_buf)) {               // also catches json_serialize() returning -1
+        return (STAT_JSON_OUTPUT_TOO_LONG);
+    }
+    return (STAT_OK);
+}
+
+static char _batch_buf[OUTPUT_BUFFER_LEN];          // the batch response, written when complete
+#define BATCH_FOOTER_LEN 24                         // },"f":[1,sss,lllll]}\n and a NUL
+
+static stat_t _json_batch_get(char *str)
+{
+    if ((js.json_verbosity == JV_SILENT) || (js.json_verbosity == JV_EXCEPTIONS) || (cs.responses_suppressed)) {
+        return (STAT_NOOP);
+    }
+    jsScan_t start = { str, str + JSON_INPUT_STRING_MAX };
+    if (_scan_char(&start) != '{') {
+        return (STAT_NOOP);
+    }
+
+    // syntax pass - everything must be a known, single config key with a null value
+    char key[TOKEN_LEN+1];
+    jsScan_t scan = start;
+    uint16_t count = 0;
+    uint16_t len;
+    stat_t status;
+    do {
+        if ((status = _json_next_batch_key(&scan, key)) > STAT_EAGAIN) {
+            return (STAT_NOOP);
+        }
+        index_t index = nv_get_index((const char *)"", key);
+        if ((index == NO_MATCH) || nv_index_is_group(index)) {
+            return (STAT_NOOP);
+        }
+        strcpy(nv_body->token, key);
+        if (nv_get_type(nv_body) != NV_TYPE_CONFIG) {
+            return (STAT_NOOP);
+        }
+        count++;
+    } while (status == STAT_EAGAIN);
+    if (count < 2) {                                // single GETs are cheaper through the regular path
+        return (STAT_NOOP);
+    }
+
+    // execution pass - GET and serialize each key once, into the response buffer
+    char *out = _batch_buf;
+    char *out_max = _batch_buf + sizeof(_batch_buf) - BATCH_FOOTER_LEN;
+    bool need_a_comma = false;
+    status = STAT_OK;
+    strcpy(out, "{\"r\":{"); out += 6;
+    scan = start;
+    do {
+        _json_next_batch_key(&scan, key);
+        if ((status = _json_batch_serialize(key, &len)) != STAT_OK) {
+            if (status != STAT_JSON_OUTPUT_TOO_LONG) {
+                nv_reset_nv_list();
+                return (STAT_NOOP);                 // the regular parser reports the failed GET
+            }
+            break;
+        }
+        if (len > 3) {                              // strip the enclosing curlies and the newline
+            if (out + need_a_comma + (len-3) > out_max) {
+                status = STAT_JSON_OUTPUT_TOO_LONG;
+                break;
+            }
+            if (need_a_comma) { *out++ = ','; }
+            memcpy(out, cs.out_buf+1, len-3);
+            out += len-3;
+            need_a_comma = true;
+        }
+    } while (--count);
+    nv_reset_nv_list();                             // don't leave the last key's list lying around
+
+    if (status != STAT_OK) {                        // send none of it, just the error footer
+        out = _batch_buf + 6;
+    }
+    strcpy(out, "},\"f\":[1,"); out += 9;         // footer - see json_print_response()
+    out += inttoa(out, status);
+    strcpy(out++, ",");
+    out += inttoa(out, cs.linelen+1);
+    strcpy(out, "]}\n");
+    cs.linelen = 0;
+    xio_writeline(_batch_buf);
+
+    sr_request_status_report(SR_REQUEST_TIMED);
+    return (STAT_COMPLETE);
+}
+
 // (*) Note: The JSON / token system is essentially flat, as it was derived from a command-line flat-ASCII approach
 //     If the JSON objects had proper recursive descent handlers that just passed the remaining string (at that level)
 //     off for further processing, we would not need to do this hack. A fix is in the works. For now, this is OK.
@@ -151,12 +303,7 @@ static stat_t _json_parser_kernal(nvObj_t *nv, char *str)
     int8_t depth;
     char group[GROUP_LEN+1] = {""};                 // group identifier - starts as NUL
     int8_t i = NV_BODY_LEN;
-
-    status = _normalize_json_string(str, JSON_INPUT_STRING_MAX);
-    if (status != STAT_OK) {
-        nv->valuetype = TYPE_NULL;
-        return (status);
-    }
+    jsScan_t scan = { str, str + JSON_INPUT_STRING_MAX };
 
     // parse the JSON command into the nv body
     do {
@@ -165,8 +312,11 @@ static stat_t _json_parser_kernal(nvObj_t *nv, char *str)
         }
         // Use relaxed parser. Will read either strict or relaxed mode. To use strict-only parser refer
         // to build earlier than 407.03. Substitute _get_nv_pair_strict() for _get_nv_pair()
-        if ((status = _get_nv_pair(nv, &str, &depth)) > STAT_EAGAIN) { // erred out
+        if ((status = _get_nv_pair(nv, &scan, &depth)) > STAT_EAGAIN) { // erred out
             nv->valuetype = TYPE_NULL;
+            if (scan.rd >= scan.end) {
+                return (STAT_INPUT_EXCEEDS_MAX_LENGTH);
+            }
             return (status);
         }
         // propagate the group from previous NV pair (if relevant)
@@ -191,49 +341,150 @@ static stat_t _json_parser_kernal(nvObj_t *nv, char *str)
 }
 
 /*
- * _normalize_json_string - normalize a JSON string in place
+ * _scan_char() - return the next significant character, lower cased, without consuming it
  *
- *  Validate string size limits, remove all whitespace and convert
- *  to lower case, with the exception of gcode comments
+ *  Skips control characters, whitespace and DEL in the raw input so the string never has
+ *  to be normalized up front. Returns NUL at the end of the string, or if the read pointer
+ *  has run past JSON_INPUT_STRING_MAX (the caller reports that as a length error).
  */
 
-static stat_t _normalize_json_string(char *str, uint16_t size)
+static char _scan_char(jsScan_t *scan)
 {
-    char *wr;                                       // write pointer
-    uint8_t in_comment = false;
+    while ((*scan->rd != NUL) && ((*scan->rd <= ' ') || (*scan->rd == DEL))) {
+        scan->rd++;
+    }
+    if (scan->rd >= scan->end) {
+        return (NUL);
+    }
+    return (tolower(*scan->rd));
+}
+
+/*
+ * _get_nv_name() - read the next name into token
+ *
+ *  Skips leading curlies, commas and quotes, copies the name up to the closing quote or
+ *  colon, and leaves the cursor just past that separator. Nothing is written to the input.
+ */
 
-    if (strlen(str) > size) {
-        return (STAT_INPUT_EXCEEDS_MAX_LENGTH);
+static stat_t _get_nv_name(jsScan_t *scan, char *token)
+{
+    char c;
+    for (uint8_t i=0; true; i++, scan->rd++) {      // find leading character of name
+        if ((c = _scan_char(scan)) == NUL) {
+            return (STAT_JSON_SYNTAX_ERROR);
+        }
+        if ((c != '{') && (c != ',') && (c != '"')) {
+            break;
+        }
+        if (i == MAX_PAD_CHARS) {
+            return (STAT_JSON_SYNTAX_ERROR);
+        }
     }
-    for (wr = str; *str != NUL; str++) {
+    for (uint8_t i=0; true; i++, scan->rd++) {      // copy to the end of name
+        if ((c = _scan_char(scan)) == NUL) {
+            token[0] = NUL;                         // don't leave a partial name for the error echo
+            return (STAT_JSON_SYNTAX_ERROR);
+        }
+        if ((c == ':') || (c == '"')) {
+            token[i] = NUL;
+            scan->rd++;
+            return (STAT_OK);
+        }
+        if (i == TOKEN_LEN) {
+            token[0] = NUL;
+            return (STAT_INPUT_EXCEEDS_MAX_LENGTH);
+        }
+        token[i] = c;
+    }
+}
+
+/*
+ * _get_nv_string() - read a quoted string value into the nv string storage
+ *
+ *  Enter with the cursor on the opening quote. The string is compacted in place as it is
+ *  read - whitespace dropped and lower cased except within gcode comments - then NUL
+ *  terminated and copied to the nv. Strings starting with 0x are read as TYPE_DATA. Strings
+ *  that run past JSON_INPUT_STRING_MAX fail with STAT_INPUT_EXCEEDS_MAX_LENGTH.
+ */
+
+static stat_t _get_nv_string(nvObj_t *nv, jsScan_t *scan)
+{
+    char *start = ++scan->rd;
+    char *wr = start;
+    bool in_comment = false;
+
+    for (char c; (c = *scan->rd) != '"'; scan->rd++) {
+        if (scan->rd >= scan->end) {
+            return (STAT_INPUT_EXCEEDS_MAX_LENGTH);
+        }
+        if (c == NUL) {
+            return (STAT_JSON_SYNTAX_ERROR);        // unterminated string
+        }
         if (!in_comment) {                          // normal processing
-            if (*str == '(') in_comment = true;
-            if ((*str <= ' ') || (*str == DEL)) continue; // toss ctrls, WS & DEL
-            *wr++ = tolower(*str);
+            if (c == '(') in_comment = true;
+            if ((c <= ' ') || (c == DEL)) continue; // toss ctrls, WS & DEL
+            *wr++ = tolower(c);
         } else {                                    // Gcode comment processing
-            if (*str == ')') in_comment = false;
-            *wr++ = *str;
+            if (c == ')') in_comment = false;
+            *wr++ = c;
         }
     }
     *wr = NUL;
-    return (STAT_OK);
+    scan->rd++;                                     // past the closing quote
+
+    // if string begins with 0x it might be data, needs to be at least 3 chars long
+    if (((wr - start) >= 3) && (start[0] == '0') && (start[1] == 'x')) {
+        uint32_t *v = (uint32_t*)&nv->value_int;
+        *v = strtoul((const char *)start, 0L, 0);
+        nv->valuetype = TYPE_DATA;
+        return (STAT_OK);
+    }
+    nv->valuetype = TYPE_STRING;
+    return (nv_copy_string(nv, start));
+}
+
+/*
+ * _get_nv_terminator() - advance past the end of a value
+ *
+ *  Skips to the next comma, close curly or quote. Returns STAT_EAGAIN if another
+ *  name-value pair follows, STAT_OK if parsing is complete.
+ */
+
+static stat_t _get_nv_terminator(jsScan_t *scan, int8_t *depth)
+{
+    while (strchr("},\"", *scan->rd) == NULL) {     // advance to terminator or err out
+        scan->rd++;
+    }
+    if (*scan->rd == NUL) {
+        return (STAT_JSON_SYNTAX_ERROR);
+    }
+    if (*scan->rd == '}') {
+        *depth -= 1;                                // pop up a nesting level
+        scan->rd++;                                 // advance to comma or whatever follows
+    }
+    if (_scan_char(scan) == ',') {
+        return (STAT_EAGAIN);                       // signal that there is more to parse
+    }
+    scan->rd++;
+    return (STAT_OK);                               // signal that parsing is complete
 }
 
 /*
  * _get_nv_pair() - get the next name-value pair w/relaxed JSON rules. Also parses strict JSON.
  *
- *  Parse the next statement and populate the command object (nvObj).
+ *  Tokenize the next statement from the raw input and populate the command object (nvObj).
+ *  This is a single pass - names are lower cased and whitespace is skipped as the cursor
+ *  moves, and values are converted straight from the input. Only string values write
+ *  back to the input, and only within their own quotes (see _get_nv_string()).
  *
- *  Leaves string pointer (str) on the first character following the object.
- *  Which is the character just past the ',' separator if it's a multi-valued
- *  object or the terminating NUL if single object or the last in a multi.
+ *  Leaves the cursor on the first character following the object.
+ *  Which is the ',' separator if it's a multi-valued object or just past the
+ *  terminating character if single object or the last in a multi.
  *
  *  Keeps track of tree depth and closing braces as much as it has to.
  *  If this were to be extended to track multiple parents or more than two
  *  levels deep it would have to track closing curlies - which it does not.
  *
- *  ASSUMES INPUT STRING HAS FIRST BEEN NORMALIZED BY _normalize_json_string()
- *
  *  If a group prefix is passed in it will be pre-pended to any name parsed
  *  to form a token string. For example, if "x" is provided as a group and
  *  "fr" is found in the name string the parser will search for "xfr" in the
@@ -247,76 +498,74 @@ static stat_t _normalize_json_string(char *str, uint16_t size)
  *  See build 406.xx or earlier for strict JSON parser - deleted in 407.03
  */
 
-static stat_t _get_nv_pair(nvObj_t *nv, char **pstr, int8_t *depth)
+static stat_t _get_nv_pair(nvObj_t *nv, jsScan_t *scan, int8_t *depth)
 {
-    uint8_t i;
+    char c;
     char *tmp;
-    char leaders[] = {"{,\""};      // open curly, quote and leading comma
-    char separators[] = {":\""};    // colon and quote
-    char terminators[] = {"},\""};  // close curly, comma and quote
-    char value[] = {"{\".-+"};      // open curly, quote, period, minus and plus
 
-    nv_reset_nv(nv);                // wipes the object and sets the depth
+    nv_reset_nv(nv);                                // wipes the object and sets the depth
 
     // --- Process name part ---
-    // Find, terminate and set pointers for the name. Allow for leading and trailing name quotes.
-    char * name = *pstr;
-    for (i=0; true; i++, (*pstr)++) {
-        if (strchr(leaders, (int)**pstr) == NULL) {     // find leading character of name
-            name = (*pstr)++;
-            break;
-        }
-        if (i == MAX_PAD_CHARS) {
-            return (STAT_JSON_SYNTAX_ERROR);
-        }
-    }
-
-    // Find the end of name, NUL terminate and copy token
-    for (i=0; true; i++, (*pstr)++) {
-        if (strchr(separators, (int)**pstr) != NULL) {
-            *(*pstr)++ = NUL;
-            strncpy(nv->token, name, TOKEN_LEN+1);      // copy the string to the token
-            break;
-        }
-        if (i == TOKEN_LEN) {
-            return (STAT_INPUT_EXCEEDS_MAX_LENGTH);
-        }
-    }
+    ritorno(_get_nv_name(scan, nv->token));
 
     // --- Process value part ---  (organized from most to least frequently encountered)
 
     // Find the start of the value part
-    for (i=0; true; i++, (*pstr)++) {
-        if (isalnum((int)**pstr)) break;
-        if (strchr(value, (int)**pstr) != NULL) break;
+    for (uint8_t i=0; true; i++, scan->rd++) {
+        if ((c = _scan_char(scan)) == NUL) {
+            return (STAT_JSON_SYNTAX_ERROR);
+        }
+        if (isalnum(c) || (strchr("{\".-+", c) != NULL)) {
+            break;
+        }
         if (i == MAX_PAD_CHARS) {
             return (STAT_JSON_SYNTAX_ERROR);
         }
     }
 
     // nulls (gets)
-    if ((**pstr == 'n') || ((**pstr == '\"') && (*(*pstr+1) == '\"'))) { // process null value
+    if (c == 'n') {
         nv->valuetype = TYPE_NULL;
         nv->value_int = TYPE_NULL;
 
+    // strings, and the empty string which is also a get
+    } else if (c == '"') {
+        tmp = scan->rd++;
+        if (_scan_char(scan) == '"') {
+            nv->valuetype = TYPE_NULL;
+            nv->value_int = TYPE_NULL;
+        } else {
+            scan->rd = tmp;
+            ritorno(_get_nv_string(nv, scan));
+        }
+
     // numbers
-    } else if (isdigit(**pstr) || (**pstr == '-')) {    // value is a number
-        nv->value_int = atol(*pstr);                    // get the number as an integer
-        nv->value_flt = strtod(*pstr, &tmp);            // get the number as a float - tmp is the end pointer
+    } else if (isdigit(c) || (c == '-')) {          // value is a number
+        bool negative = (c == '-');
+        if (negative) {                             // whitespace may follow the minus sign
+            scan->rd++;
+            if (((c = _scan_char(scan)) == '-') || (c == '+')) {
+                nv->valuetype = TYPE_NULL;
+                return (STAT_BAD_NUMBER_FORMAT);
+            }
+        }
+        nv->value_int = atol(scan->rd);             // get the number as an integer
+        nv->value_flt = strtod(scan->rd, &tmp);     // get the number as a float - tmp is the end pointer
 
-        if ((tmp == *pstr) ||                           // if start pointer equals end the conversion failed
-            (strchr(terminators, *tmp) == NULL)) {      // terminators are the only legal chars at the end of a number
-            nv->valuetype = TYPE_NULL;                  // report back an error
+        if (tmp == scan->rd) {                      // if start pointer equals end the conversion failed
+            nv->valuetype = TYPE_NULL;              // report back an error
             return (STAT_BAD_NUMBER_FORMAT);
         }
-
-        // if the double value is the same as the int, mark it as a TYPE_INTEGER
-        if ((int32_t)std::floor(nv->value_flt) == nv->value_int) {
-            nv->valuetype = TYPE_INTEGER;
-        } else {
-            nv->valuetype = TYPE_FLOAT;
+        if (negative) {
+            nv->value_int = -nv->value_int;
+            nv->value_flt = -nv->value_flt;
+        }
+        scan->rd = tmp;
+        c = _scan_char(scan);
+        if ((c != NUL) && (c != '}') && (c != ',') && (c != '"')) { // terminators are the only legal chars at the end of a number
+            nv->valuetype = TYPE_NULL;
+            return (STAT_BAD_NUMBER_FORMAT);
         }
-
 
         // if the double value is the same as the int, mark it as a TYPE_INTEGER
         if ((int32_t)std::floor(nv->value_flt) == nv->value_int) {
@@ -325,66 +574,34 @@ static stat_t _get_nv_pair(nvObj_t *nv, char **pstr, int8_t *depth)
             nv->valuetype = TYPE_FLOAT;
         }
 
-
-        // object parent
-    } else if (**pstr == '{') {
+    // object parent
+    } else if (c == '{') {
         nv->valuetype = TYPE_PARENT;
-//        *depth += 1;                                  // nv_reset_nv() sets the next object's level so this is redundant
-        (*pstr)++;
-        return(STAT_EAGAIN);                            // signal that there is more to parse
-
-    // strings
-    } else if (**pstr == '\"') {                        // value is a string
-        (*pstr)++;
-        nv->valuetype = TYPE_STRING;
-        if ((tmp = strchr(*pstr, '\"')) == NULL) {
-            return (STAT_JSON_SYNTAX_ERROR);            // find the end of the string
-        }
-        *tmp = NUL;
-
-        // if string begins with 0x it might be data, needs to be at least 3 chars long
-        if( strlen(*pstr)>=3 && (*pstr)[0]=='0' && (*pstr)[1]=='x')
-        {
-            uint32_t *v = (uint32_t*)&nv->value_int;
-            *v = strtoul((const char *)*pstr, 0L, 0);
-            nv->valuetype = TYPE_DATA;
-        } else {
-            ritorno(nv_copy_string(nv, *pstr));
-        }
-        *pstr = ++tmp;
+//        *depth += 1;                              // nv_reset_nv() sets the next object's level so this is redundant
+        scan->rd++;
+        return(STAT_EAGAIN);                        // signal that there is more to parse
 
     // boolean true/false
-    } else if (**pstr == 't') {
+    } else if (c == 't') {
         nv->valuetype = TYPE_BOOLEAN;
         nv->value_int = true;
-    } else if (**pstr == 'f') {
+    } else if (c == 'f') {
         nv->valuetype = TYPE_BOOLEAN;
         nv->value_int = false;
 
     // arrays
-    } else if (**pstr == '[') {
+    } else if (c == '[') {
         nv->valuetype = TYPE_ARRAY;
-        ritorno(nv_copy_string(nv, *pstr));     // copy array into string for error displays
-        return (STAT_VALUE_TYPE_ERROR);         // return error as the parser doesn't do input arrays yet
+        ritorno(nv_copy_string(nv, scan->rd));      // copy array into string for error displays
+        return (STAT_VALUE_TYPE_ERROR);             // return error as the parser doesn't do input arrays yet
 
     // general error condition
     } else {
-        return (STAT_JSON_SYNTAX_ERROR);        // ill-formed JSON
+        return (STAT_JSON_SYNTAX_ERROR);            // ill-formed JSON
     }
 
     // process comma separators and end curlies
-    if ((*pstr = strpbrk(*pstr, terminators)) == NULL) { // advance to terminator or err out
-        return (STAT_JSON_SYNTAX_ERROR);
-    }
-    if (**pstr == '}') {
-        *depth -= 1;                            // pop up a nesting level
-        (*pstr)++;                              // advance to comma or whatever follows
-    }
-    if (**pstr == ',') {
-        return (STAT_EAGAIN);                   // signal that there is more to parse
-    }
-    (*pstr)++;
-    return (STAT_OK);                           // signal that parsing is complete
+    return (_get_nv_terminator(scan, depth));
 }
 
 /****************************************************************************
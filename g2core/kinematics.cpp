@@ -30,7 +30,9 @@
 #include "config.h"
 #include "canonical_machine.h"
 #include "stepper.h"
+#include "planner.h"
 #include "kinematics.h"
+#include "text_parser.h"
 #include "util.h"
 #include "settings.h"
 #include "gpio.h"
@@ -194,6 +196,11 @@ struct CartesianKinematics : KinematicsBase<axes, motors> {
             // This, solved for motor_offset: step_position[motor] = (position[joint]] * steps_per_unit[motor]) + motor_offset[motor];
             motor_offset[motor] = step_position[motor] - (position[joint] * steps_per_unit[motor]);
         }
+
+        // get_position() reads back from here
+        for (uint8_t joint = 0; joint < joints; joint++) {
+            joint_position[joint] = position[joint];
+        }
     }
 };
 
@@ -215,25 +222,35 @@ struct CoreXYKinematics final : CartesianKinematics<axes, motors> {
     //  7 = V (maybe)
     //  8 = W (maybe)
 
+    // The COREXY A and B are the X and Y axes mixed as follows, the rest are just copied
+    static void to_joints(const float position[axes], float joint_target[axes])
+    {
+        joint_target[0] = position[0] + position[1];
+        joint_target[1] = position[0] - position[1];
+        for (uint8_t axis = 2; axis < axes; axis++) {
+            joint_target[axis] = position[axis];
+        }
+    }
+
     void inverse_kinematics(const float target[axes], const float position[axes], const float start_velocity,
                             const float end_velocity, const float segment_time, float steps[motors]) override
     {
         // need to have a place to store the adjusted COREXY A and B
         float axes_target[axes];
-
-        // The COREXY A and B are the X and Y axes mixed as follows
-        axes_target[0]=target[0]+target[1];
-        axes_target[1]=target[0]-target[1];
-
-        // the rest are just copied
-        for (uint8_t axis = 2; axis < AXES; axis++) {
-            axes_target[axis]=target[axis];
-        }
+        to_joints(target, axes_target);
 
         // just use the cartesian method from here on
         parent::inverse_kinematics(axes_target, position, start_velocity, end_velocity, segment_time, steps);
     }
 
+    void sync_encoders(const float step_position[motors], const float position[axes]) override
+    {
+        // the motor offsets are in joint space, so sync to the A and B of this position
+        float axes_position[axes];
+        to_joints(position, axes_position);
+        parent::sync_encoders(step_position, axes_position);
+    }
+
     void forward_kinematics(const float steps[motors], float position[axes]) override
     {
         // start by letting the cartesian kinematics work
@@ -325,6 +342,14 @@ struct FourCableKinematics : KinematicsBase<axes, motors> {
     double cable_external_encoder_position[4];  // Number of rotations of the external encoders
     double cable_encoder_offset[4];  // amount of error tracked by the external encoders vs the internal encoders
     double cable_encoder_error[4];  // amount of error detected in this last pass (ephemeral)
+
+    // precomputed for the fast path - body point minus frame point for each cable, so the
+    // cable vector for a target is just (target + offset), with j_sq[] supplying the z term
+    float cable_offset_x[4];
+    float cable_offset_y[4];
+    float ideal_cable_length[4];     // cable lengths for last_target, before encoder and idle adjustments
+    float last_target[2];            // X and Y that ideal_cable_length[] was computed for
+    bool ideal_cable_length_valid = false;
     uint8_t cable_external_encoder_reads[4];  // keep track of how many times the encoder is read before uses
     bool encoder_needs_read[4];               // as it says - used to know when to request another sensor read
     bool encoder_synced[4];  // used to know when the encoer offset is valid (false means no, and they need synced)
@@ -434,6 +459,8 @@ struct FourCableKinematics : KinematicsBase<axes, motors> {
         for (uint8_t cable = 0; cable < 4; cable++) {
             j[cable] = body_points[cable][3] - frame_points[cable][3];
             j_sq[cable] = j[cable] * j[cable];
+            cable_offset_x[cable] = body_points[cable].x - frame_points[cable].x;
+            cable_offset_y[cable] = body_points[cable].y - frame_points[cable].y;
             cable_vel[cable] = 0;
             cable_accel[cable] = 0;
             cable_jerk[cable] = 0;
@@ -482,10 +509,32 @@ struct FourCableKinematics : KinematicsBase<axes, motors> {
 
         // din_handlers[INPUT_ACTION_NONE].registerHandler(&_pin_input_handler);
 
+        ideal_cable_length_valid = false;
         inited_ = true; // only allow init to happen once
     }
+
     void compute_cable_position(const float target[axes])
     {
+#if FOUR_CABLE_FAST_IK
+        // Same float math as the Point3F path below, without the temporaries. Only X and Y
+        // change the cable lengths, so segments that move other axes alone (and repeated
+        // targets) reuse the last lengths without any square roots. cable_position[] itself
+        // is always rewritten, as encoder correction and idle_task() move it away from the
+        // ideal lengths between segments.
+        if (!ideal_cable_length_valid || (target[0] != last_target[0]) || (target[1] != last_target[1])) {
+            for (uint8_t cable = 0; cable < 4; cable++) {
+                const float x = target[0] + cable_offset_x[cable];
+                const float y = target[1] + cable_offset_y[cable];
+                ideal_cable_length[cable] = std::sqrt(x*x + y*y + (float)j_sq[cable]);
+            }
+            last_target[0] = target[0];
+            last_target[1] = target[1];
+            ideal_cable_length_valid = true;
+        }
+        for (uint8_t cable = 0; cable < 4; cable++) {
+            cable_position[cable] = ideal_cable_length[cable];
+        }
+#else
         Point3F target_point = {target[0], target[1], 0};
 
         // 0 Compute the four cable lengths
@@ -535,6 +584,7 @@ struct FourCableKinematics : KinematicsBase<axes, motors> {
         cable_position[2] = b[2];
         cable_position[3] = b[3];
 #endif
+#endif // FOUR_CABLE_FAST_IK
 
         // squirrel away the other axes
         for (uint8_t axis = 2; axis < axes; axis++) {
@@ -1050,18 +1100,30 @@ struct FourCableKinematics : KinematicsBase<axes, motors> {
  *
  */
 
-// Note that with this technically kn can be switched at runtime
-#if KINEMATICS==KINE_CARTESIAN
+// Kinematics that need no extra hardware are always built so kn can be switched at runtime ($kn).
+// KINEMATICS is the power-on default, and also gates the ones that need board support (four cable).
+// Switching only re-points kn, so every segment costs the same single virtual call into the
+// selected class whichever one is active.
 CartesianKinematics<AXES, MOTORS> cartesian_kinematics;
-KinematicsBase<AXES, MOTORS> *kn = &cartesian_kinematics;
+CoreXYKinematics<AXES, MOTORS> core_xy_kinematics;
+#if KINEMATICS==KINE_FOUR_CABLE
+FourCableKinematics<AXES, MOTORS> four_cable_kinematics;
 #endif
-#if KINEMATICS==KINE_CORE_XY
-CartesianKinematics<AXES, MOTORS> core_xy_kinematics;
-KinematicsBase<AXES, MOTORS> *kn = &core_xy_kinematics;
+
+// indexed by KINE_xxx - nullptr for kinematics not built into this configuration
+static KinematicsBase<AXES, MOTORS> * const kn_registry[] = {
+    &cartesian_kinematics,                  // KINE_CARTESIAN
+    &core_xy_kinematics,                    // KINE_CORE_XY
+#if KINEMATICS==KINE_FOUR_CABLE
+    &four_cable_kinematics,                 // KINE_FOUR_CABLE
+#else
+    nullptr,
 #endif
+};
+static uint8_t kn_type = KINEMATICS;
+KinematicsBase<AXES, MOTORS> *kn = kn_registry[KINEMATICS];
+
 #if KINEMATICS==KINE_FOUR_CABLE
-FourCableKinematics<AXES, MOTORS> four_cable_kinematics;
-KinematicsBase<AXES, MOTORS> *kn = &four_cable_kinematics;
 
 // gpioDigitalInputHandler _pin_input_handler{
 //     [&](const bool state, const inputEdgeFlag edge, const uint8_t triggering_pin_number) {
@@ -1142,6 +1204,38 @@ stat_t kn_get_pos_d(nvObj_t *nv)
 };
 #endif // KINEMATICS==KINE_FOUR_CABLE
 
+/*
+ * kn_get_kn() - get the active kinematics type
+ * kn_set_kn() - select the active kinematics type
+ * kn_get_type() - the active kinematics type, for internal use
+ *
+ *  The new kinematics is configured from the current motor settings and synced to the current
+ *  step position, so the machine doesn't move on the switch. Switching is refused while anything
+ *  is moving or queued, as queued moves would otherwise run through a different joint mapping.
+ */
+
+stat_t kn_get_kn(nvObj_t *nv) { return(get_integer(nv, kn_type)); }
+uint8_t kn_get_type() { return (kn_type); }
+
+stat_t kn_set_kn(nvObj_t *nv)
+{
+    if ((nv->value_int < KINE_CARTESIAN) || (nv->value_int > KINE_FOUR_CABLE) ||
+        (kn_registry[nv->value_int] == nullptr)) {
+        nv->valuetype = TYPE_NULL;
+        return (STAT_INPUT_VALUE_RANGE_ERROR);
+    }
+    if (nv->value_int == kn_type) {
+        return (STAT_OK);
+    }
+    if ((cm_get_motion_state() != MOTION_STOP) || mp_has_runnable_buffer(mp)) {
+        return (STAT_COMMAND_NOT_ACCEPTED);
+    }
+    kn_type = nv->value_int;
+    kn = kn_registry[kn_type];
+    kn_config_changed();
+    return (STAT_OK);
+}
+
 /*
  * kn_config_changed() - call to update the configuration from the globals
  */
@@ -1170,6 +1264,8 @@ void kn_config_changed() {
 /*
  * kn_forward_kinematics() - forward kinematics for a cartesian machine
  *
+ * Returns the commanded position - any height map compensation is taken back out.
+ *
  * This is designed for PRECISION, not PERFORMANCE!
  *
  * This function is NOT to be used where high-speed is important. If that becomes the case,
@@ -1180,4 +1276,17 @@ void kn_config_changed() {
 void kn_forward_kinematics(const float steps[], float travel[]) {
     // PRESUMPTION: inverse kinematics has been called at least once since the mapping or steps_unit has changed
     kn->forward_kinematics(steps, travel);
+    mp_mesh_uncompensate(travel);   // steps follow the height map, return the commanded position
 }
+
+/***********************************************************************************
+ * TEXT MODE SUPPORT
+ * Functions to print variables from the cfgArray table
+ ***********************************************************************************/
+
+#ifdef __TEXT_MODE
+
+static const char fmt_kn[] = "[kn]  kinematics%19d [0=cartesian,1=coreXY,2=four cable]\n";
+void kn_print_kn(nvObj_t *nv) { text_print(nv, fmt_kn);}    // TYPE_INT
+
+#endif // __TEXT_MODE
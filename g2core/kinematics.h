@@ -95,7 +95,18 @@ stat_t kn_get_pos_c(nvObj_t *nv);
 stat_t kn_get_pos_d(nvObj_t *nv);
 #endif
 
+// kinematics type, selected at runtime
+stat_t kn_get_kn(nvObj_t *nv);
+stat_t kn_set_kn(nvObj_t *nv);
+uint8_t kn_get_type();
+
 void kn_config_changed();
 void kn_forward_kinematics(const float steps[], float travel[]);
 
+#ifdef __TEXT_MODE
+    void kn_print_kn(nvObj_t *nv);
+#else
+    #define kn_print_kn tx_print_stub
+#endif // __TEXT_MODE
+
 #endif  // End of include Guard: KINEMATICS_H_ONCE
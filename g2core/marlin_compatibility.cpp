@@ -388,6 +388,22 @@ stat_t marlin_set_fan_speed(const uint8_t fan, float speed)
     return (STAT_OK);
 }
 
+/***********************************************************************************
+ * marlin_autotune_heater() - M303 called from gcode parser
+ *
+ *  E is 0-based for the extruders and -1 for the bed, C of 0 is the default cycle count.
+ *  Unlike Marlin this doesn't block - the result is reported when autotune is done, and
+ *  the tuned values are used right away as with M303 U1.
+ */
+
+stat_t marlin_autotune_heater(const float heater, const float temperature, const float cycles)
+{
+    if ((heater < -1) || (heater > 1) || (cycles < 0) || (cycles > 255)) {
+        return STAT_INPUT_VALUE_RANGE_ERROR;
+    }
+    return (cm_start_heater_autotune((heater < 0) ? 3 : (uint8_t)heater + 1, temperature, (uint8_t)cycles));
+}
+
 /***********************************************************************************
  * marlin_request_position_report() - M114 called from gcode parser
  */
@@ -54,6 +54,7 @@ stat_t marlin_set_motor_timeout(float s);                       // M84 Sxxx, M85
 stat_t marlin_set_temperature(uint8_t tool, float temperature, bool wait); // M104, M109, M140, M190
 stat_t marlin_request_temperature_report();                     // M105
 stat_t marlin_set_fan_speed(const uint8_t fan, float speed);    // M106, M107
+stat_t marlin_autotune_heater(const float heater, const float temperature, const float cycles); // M303
 
 stat_t marlin_request_position_report();                        // M114
 stat_t marlin_report_version();                                 // M115
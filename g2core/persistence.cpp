@@ -56,6 +56,36 @@ stat_t read_persistent_value(nvObj_t *nv)
     return persistence->read(nv);
 }
 
+/*
+ * read_persistent_values() - bulk restore of all initialized single-valued items
+ *
+ *  For every single-valued cfgArray item flagged F_INITIALIZE the nv is loaded with the
+ *  index, token and persisted value, then restore(nv) is called. Backends that can read
+ *  the whole image in one pass should override read_all(); the default falls back to
+ *  one read() per item.
+ */
+
+stat_t read_persistent_values(nvObj_t *nv, fptrRestore restore)
+{
+    if (persistence == nullptr) {
+        return (STAT_OK);
+    }
+
+    return persistence->read_all(nv, restore);
+}
+
+stat_t Persistence::read_all(nvObj_t *nv, fptrRestore restore)
+{
+    for (nv->index=0; nv_index_is_single(nv->index); nv->index++) {
+        if (GET_TABLE_BYTE(flags) & F_INITIALIZE) {
+            strncpy(nv->token, cfgArray[nv->index].token, TOKEN_LEN);
+            ritorno(read(nv));
+            restore(nv);
+        }
+    }
+    return (STAT_OK);
+}
+
 /*
  * write_persistent_value() - write to NVM by index, but only if the value has changed
  *
@@ -43,6 +43,7 @@ static stat_t _exec_aline_head(mpBuf_t *bf); // passing bf because body might ne
 static stat_t _exec_aline_body(mpBuf_t *bf); // passing bf so that body can extend itself if the exit velocity rises.
 static stat_t _exec_aline_tail(mpBuf_t *bf);
 static stat_t _exec_aline_segment(void);
+static bool _exec_shaper_drain(void);
 static void   _exec_aline_normalize_block(mpBlockRuntimeBuf_t *b);
 static stat_t _exec_aline_feedhold(mpBuf_t *bf);
 
@@ -257,6 +258,9 @@ stat_t mp_exec_move()
     // NULL means nothing's running - this is OK
     // If something is MP_BUFFER_BACK_PLANNED, we don't want to idle or prep_null()
     if ((bf = mp_get_run_buffer()) == NULL || (bf->buffer_state < MP_BUFFER_BACK_PLANNED)) {
+        if (_exec_shaper_drain()) {
+            return STAT_OK;
+        }
         if (kn->idle_task()) {
             return STAT_OK; // IOW: we need something loaded
         }
@@ -305,6 +309,8 @@ stat_t mp_exec_move()
         if (bf->nx->buffer_state >= MP_BUFFER_BACK_PLANNED) {
             st_request_forward_plan();
         }
+    } else if (_exec_shaper_drain()) {      // commands run when the motion before them is done,
+        return (STAT_OK);                   // so let input shaping finish it first
     }
     if (bf->bf_func == NULL) {
         return(cm_panic(STAT_INTERNAL_ERROR, "mp_exec_move()")); // never supposed to get here
@@ -912,8 +918,11 @@ static stat_t _exec_aline_segment()
         }
     }
 
-    // Convert target position to steps
-    kn->inverse_kinematics(mr->gm.target, mr->position, mr->segment_velocity, mr->target_velocity, mr->segment_time, exec_target_steps);
+    // Apply height map compensation and input shaping, then convert target position to steps
+    float compensated[AXES];
+    mp_mesh_compensate(mr->gm.target, compensated);
+    const float *target = mp_shape_segment(compensated, mr->segment_time);
+    kn->inverse_kinematics(target, mp_shaper_position(), mr->segment_velocity, mr->target_velocity, mr->segment_time, exec_target_steps);
 
     // Update the mb->run_time_remaining -- we know it's missing the current segment's time before it's loaded, that's ok.
     mp->run_time_remaining -= mr->segment_time;
@@ -921,6 +930,13 @@ static stat_t _exec_aline_segment()
         mp->run_time_remaining = 0.0;
     }
 
+    // Stage the S word and the segment's share of the cruise velocity for the toolhead (0 for traverses)
+    float velocity_factor = 0;
+    if ((mr->gm.motion_mode != MOTION_MODE_STRAIGHT_TRAVERSE) && (mr->r->cruise_velocity > EPSILON)) {
+        velocity_factor = std::min(1.0f, (mr->segment_velocity + mr->target_velocity) / (2 * mr->r->cruise_velocity));
+    }
+    st_prep_toolhead(mr->gm.spindle_speed, velocity_factor);
+
     // Set the target steps and call the stepper prep function
     ritorno(mp_set_target_steps(exec_target_steps));
 
@@ -931,6 +947,28 @@ static stat_t _exec_aline_segment()
     return (STAT_EAGAIN);                                   // this section still has more segments to run
 }
 
+/*********************************************************************************************
+ * _exec_shaper_drain() - run a segment to let input shaping catch up with the runtime position
+ *
+ *  Returns true if it prepped a segment. Used wherever motion would otherwise end while the
+ *  shaped position is still behind the runtime (see plan_shaper.cpp).
+ */
+
+static bool _exec_shaper_drain()
+{
+    if (mp_shaper_is_settled()) {
+        return (false);
+    }
+    float compensated[AXES];
+    mp_mesh_compensate(mr->position, compensated);
+    const float *target = mp_shape_segment(compensated, NOM_SEGMENT_TIME);
+    static const float no_velocity[MOTORS] = {};            // the DDA plays the steps out at a constant rate
+    kn->inverse_kinematics(target, mp_shaper_position(), 0, 0, NOM_SEGMENT_TIME, exec_target_steps);
+    st_prep_toolhead(mr->gm.spindle_speed, 0);              // the commanded path has stopped
+    mp_set_target_steps(exec_target_steps, no_velocity, no_velocity, NOM_SEGMENT_TIME);
+    return (true);
+}
+
 /*********************************************************************************************
  * _exec_aline_normalize_block() - re-organize block to eliminate minimum time segments
  *
@@ -1012,6 +1050,9 @@ static stat_t _exec_aline_feedhold(mpBuf_t *bf)
 {
     // Case (4) - Wait for the steppers to stop and complete the feedhold
     if (cm->hold_state == FEEDHOLD_MOTION_STOPPING) {
+        if (_exec_shaper_drain()) {                         // input shaping is still decelerating
+            return (STAT_OK);
+        }
         if (mp_runtime_is_idle()) {                         // wait for steppers to actually finish
 
             // Motion has stopped, so we can rely on positions and other values to be stable
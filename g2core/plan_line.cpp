@@ -68,6 +68,7 @@ static void _set_bf_diagnostics(mpBuf_t* bf) {}
  *
  * mp_zero_segment_velocity()         - correct velocity in last segment for reporting purposes
  * mp_get_runtime_velocity()          - returns current velocity (aggregate)
+ * mp_get_runtime_axis_velocity()     - returns current velocity of one axis (unsigned)
  * mp_get_runtime_machine_position()  - returns current axis position in machine coordinates
  * mp_set_runtime_display_offset()    - set combined display offsets in the MR struct
  * mp_get_runtime_display_position()  - returns current axis position in work display coordinates
@@ -76,6 +77,7 @@ static void _set_bf_diagnostics(mpBuf_t* bf) {}
 
 void  mp_zero_segment_velocity() { mr->segment_velocity = 0; }
 float mp_get_runtime_velocity(void) { return (mr->segment_velocity); }
+float mp_get_runtime_axis_velocity(const uint8_t axis) { return (mr->segment_velocity * std::abs(mr->unit[axis])); }
 float mp_get_runtime_absolute_position(mpPlannerRuntime_t *_mr, uint8_t axis) { return (_mr->position[axis]); }
 void mp_set_runtime_display_offset(float offset[]) { copy_vector(mr->gm.display_offset, offset); }
 
@@ -436,6 +438,8 @@ static mpBuf_t* _plan_block(mpBuf_t* bf)
 }
 
 /***** ALINE HELPERS *****
+ * mp_get_jerk()
+ * mp_get_stopping_length()
  * _calculate_jerk()
  * _calculate_vmaxes()
  * _calculate_junction_vmax()
@@ -452,36 +456,47 @@ static mpBuf_t* _plan_block(mpBuf_t* bf)
  * Cost about ~65 uSec
  */
 
-static float _get_axis_jerk(mpBuf_t* bf, uint8_t axis)
-{
-    if (bf->gm.motion_profile == PROFILE_FAST) {
-        return cm->a[axis].jerk_high;
-    }
-    return cm->a[axis].jerk_max;
-}
+static const float q = 2.40281141413;  // (sqrt(10)/(3^(1/4)))
 
-static void _calculate_jerk(mpBuf_t* bf)
+/*
+ * mp_get_jerk() - the largest jerk (with JERK_MULTIPLIER) a move along unit[] can use
+ *
+ *  Returns 0 if no axis is participating in the move.
+ */
+float mp_get_jerk(const float unit[], const cmMotionProfile motion_profile)
 {
-    // compute the jerk as the largest jerk that still meets axis constraints
-    bf->jerk   = 8675309;  // a ridiculously large number
     float jerk = 0;
 
     for (uint8_t axis = 0; axis < AXES; axis++) {
-        if (std::abs(bf->unit[axis]) > 0) {  // if this axis is participating in the move
-            float axis_jerk = _get_axis_jerk(bf, axis);
+        if (std::abs(unit[axis]) > 0) {  // if this axis is participating in the move
+            float axis_jerk = (motion_profile == PROFILE_FAST) ? cm->a[axis].jerk_high : cm->a[axis].jerk_max;
 
-            jerk = axis_jerk / std::abs(bf->unit[axis]);
-            if (jerk < bf->jerk) {
-                bf->jerk = jerk;
-                //              bf->jerk_axis = axis;           // +++ diagnostic
+            axis_jerk /= std::abs(unit[axis]);
+            if ((jerk == 0) || (axis_jerk < jerk)) {
+                jerk = axis_jerk;
             }
         }
     }
-    bf->jerk *= JERK_MULTIPLIER;           // goose it!
+    return (jerk * JERK_MULTIPLIER);       // goose it!
+}
+
+/*
+ * mp_get_stopping_length() - length to stop from velocity at jerk (from mp_get_jerk())
+ *
+ *  The same curve as mp_get_target_length(0, velocity, bf), for callers that have no buffer
+ */
+float mp_get_stopping_length(const float velocity, const float jerk)
+{
+    return (q / (2.0 * sqrt(jerk)) * sqrt(velocity) * velocity);
+}
+
+static void _calculate_jerk(mpBuf_t* bf)
+{
+    // compute the jerk as the largest jerk that still meets axis constraints
+    bf->jerk       = mp_get_jerk(bf->unit, bf->gm.motion_profile);
     bf->jerk_sq    = bf->jerk * bf->jerk;  // pre-compute terms used multiple times during planning
     bf->recip_jerk = 1 / bf->jerk;
 
-    const float q        = 2.40281141413;  // (sqrt(10)/(3^(1/4)))
     const float sqrt_j   = sqrt(bf->jerk);
     bf->sqrt_j           = sqrt_j;
     bf->q_recip_2_sqrt_j = q / (2.0 * sqrt_j);
@@ -0,0 +1,375 @@
+/*
+ * plan_mesh.cpp - probed height map and Z compensation
+ * This file is part of the g2core project
+ *
+ * Copyright (c) 2010 - 2019 Alden S. Hart, Jr.
+ * Copyright (c) 2012 - 2019 Rob Giseburt
+ *
+ * This file ("the software") is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2 as published by the
+ * Free Software Foundation. You should have received a copy of the GNU General Public
+ * License, version 2 along with the software.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, you may use this file as part of a software library without
+ * restriction. Specifically, if other files instantiate templates or use macros or
+ * inline functions from this file, or you compile this file and link it with  other
+ * files to produce an executable, this file does not by itself cause the resulting
+ * executable to be covered by the GNU General Public License. This exception does not
+ * however invalidate any other reasons why the executable file might be covered by the
+ * GNU General Public License.
+ *
+ * THE SOFTWARE IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL, BUT WITHOUT ANY
+ * WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT
+ * SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+ * OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+/* Height map compensation
+ *
+ *  The height map is a grid of Z heights measured by the G29.1 grid probing cycle (see
+ *  cycle_probing.cpp), relative to the first point probed. The grid starts at the origin
+ *  (machine coordinates) and has columns along X and rows along Y, spacing apart.
+ *
+ *  When compensation is enabled the height under the tool, interpolated bilinearly from the
+ *  four surrounding grid points, is added to Z. Outside the grid the height at the nearest
+ *  edge is used. Like input shaping this is applied in the exec on each segment target,
+ *  ahead of inverse kinematics, so planning is untouched - mr->position is the commanded
+ *  (uncompensated) position and the steps follow the compensated one.
+ *
+ *  Compensation is off during grid probing, and while the grid settings are invalid. The
+ *  map is persisted with the rest of the settings, so it survives a reset.
+ *
+ *  The map and its settings can only be changed while the machine is stopped and out of a
+ *  cycle - the exec would otherwise step Z by the whole change in offset on the next segment.
+ *  Any change in the offset under the tool is taken into the Z position rather than moved,
+ *  so the tool stays where it is and the next move plans the offset in (see _resync()).
+ */
+
+#include "g2core.h"
+#include "config.h"
+#include "canonical_machine.h"
+#include "planner.h"
+#include "controller.h"
+#include "text_parser.h"
+#include "xio.h"
+#include "util.h"
+
+typedef struct mpMesh {
+    bool enable;                        // compensation requested
+    bool probing;                       // grid probing cycle is running - don't compensate
+    bool active;                        // enabled and the grid is valid
+
+    float origin[2];                    // machine X and Y of the first grid point
+    float spacing[2];                   // distance between grid points in X and Y
+    uint8_t columns;                    // grid points along X
+    uint8_t rows;                       // grid points along Y
+    float height[MESH_ROWS_MAX][MESH_COLUMNS_MAX];  // Z height of each point
+
+    float inverse_spacing[2];           // precomputed for the exec
+} mpMesh_t;
+
+static mpMesh_t mh;
+
+/*
+ * _update() - re-evaluate if compensation applies after any change
+ */
+
+static void _update()
+{
+    mh.active = false;
+    if (!mh.enable || mh.probing ||
+        (mh.columns < 2) || (mh.columns > MESH_COLUMNS_MAX) ||
+        (mh.rows < 2) || (mh.rows > MESH_ROWS_MAX) ||
+        (fabs(mh.spacing[0]) < EPSILON) || (fabs(mh.spacing[1]) < EPSILON)) {
+        return;
+    }
+    mh.inverse_spacing[0] = 1 / mh.spacing[0];
+    mh.inverse_spacing[1] = 1 / mh.spacing[1];
+    mh.active = true;
+}
+
+/*
+ * _locked() - true if the map can't be changed now, as motion is running or queued
+ */
+
+static bool _locked()
+{
+    return ((cm_get_machine_state() == MACHINE_CYCLE) || (cm_get_motion_state() != MOTION_STOP) ||
+            mp_has_runnable_buffer(mp));
+}
+
+/*
+ * _height() - bilinear interpolation of the height map, held at the edge value outside it
+ */
+
+static float _height(const float x, const float y)
+{
+    float u = (x - mh.origin[0]) * mh.inverse_spacing[0];  // position in grid units
+    float v = (y - mh.origin[1]) * mh.inverse_spacing[1];
+    u = std::min(std::max(u, 0.0f), (float)(mh.columns-1));
+    v = std::min(std::max(v, 0.0f), (float)(mh.rows-1));
+
+    uint8_t c = std::min((uint8_t)u, (uint8_t)(mh.columns-2));
+    uint8_t r = std::min((uint8_t)v, (uint8_t)(mh.rows-2));
+    u -= c;
+    v -= r;
+
+    float h0 = mh.height[r][c]   + (mh.height[r][c+1]   - mh.height[r][c])   * u;
+    float h1 = mh.height[r+1][c] + (mh.height[r+1][c+1] - mh.height[r+1][c]) * u;
+    return (h0 + (h1 - h0) * v);
+}
+
+/*
+ * _offset() - the compensation at the runtime position, 0 if compensation is off
+ * _resync() - take any change in the compensation at the tool into the Z position
+ *
+ *  The steps are at the position compensated with the old map. Moving Z by the change in
+ *  the offset puts the compensated position back on the steps, so nothing moves. During
+ *  startup, when the settings are restored, the position isn't known yet and the steps are
+ *  just synced to it.
+ */
+
+static float _offset()
+{
+    if (!mh.active) {
+        return (0);
+    }
+    return (_height(mp_get_runtime_absolute_position(mr, AXIS_X), mp_get_runtime_absolute_position(mr, AXIS_Y)));
+}
+
+static void _resync(const float offset)
+{
+    float change = _offset() - offset;
+    if (fp_ZERO(change)) {
+        return;
+    }
+    if (cm_get_machine_state() == MACHINE_INITIALIZING) {
+        mp_set_steps_to_runtime_position();
+        return;
+    }
+    cm_set_position_by_axis(AXIS_Z, mp_get_runtime_absolute_position(mr, AXIS_Z) - change);
+}
+
+/*
+ * mp_mesh_compensate()   - copy position to compensated with the height map applied
+ * mp_mesh_uncompensate() - remove the height map from a compensated position, in place
+ *
+ *  The height only depends on X and Y, which compensation doesn't change, so the inverse
+ *  is exact. mp_mesh_uncompensate() is for positions read back from the steps.
+ */
+
+void mp_mesh_compensate(const float position[], float compensated[])
+{
+    copy_vector(compensated, position);
+    if (mh.active) {
+        compensated[AXIS_Z] += _height(position[AXIS_X], position[AXIS_Y]);
+    }
+}
+
+void mp_mesh_uncompensate(float position[])
+{
+    if (mh.active) {
+        position[AXIS_Z] -= _height(position[AXIS_X], position[AXIS_Y]);
+    }
+}
+
+/*
+ * mp_mesh_start()      - define a new grid and suspend compensation while it's probed
+ * mp_mesh_set_height() - record the height of one grid point
+ * mp_mesh_finish()     - end grid probing, enable compensation if it succeeded, and persist
+ *
+ *  A failed or aborted probe leaves compensation disabled, as the map is only partly measured.
+ *  The cycle only calls these with the machine stopped - after the motion before them ends.
+ */
+
+void mp_mesh_start(const float origin[], const float spacing[], const uint8_t columns, const uint8_t rows)
+{
+    float offset = _offset();
+    mh.probing = true;
+    mh.origin[0] = origin[0];
+    mh.origin[1] = origin[1];
+    mh.spacing[0] = spacing[0];
+    mh.spacing[1] = spacing[1];
+    mh.columns = columns;
+    mh.rows = rows;
+    for (uint8_t r=0; r<MESH_ROWS_MAX; r++) {
+        for (uint8_t c=0; c<MESH_COLUMNS_MAX; c++) {
+            mh.height[r][c] = 0;
+        }
+    }
+    _update();
+    _resync(offset);
+}
+
+void mp_mesh_set_height(const uint8_t column, const uint8_t row, const float height)
+{
+    mh.height[row][column] = height;
+}
+
+void mp_mesh_finish(const bool succeeded)
+{
+    if (!mh.probing) {
+        return;
+    }
+    float offset = _offset();
+    mh.probing = false;
+    mh.enable = succeeded;
+    _update();
+    _resync(offset);
+
+    nvObj_t nv;
+    const char *tokens[] = { "mshe", "mshx", "mshy", "mshdx", "mshdy", "mshc", "mshr" };
+    for (const char *token : tokens) {
+        nv.index = nv_get_index((const char *)"", token);
+        nv_persist(&nv);            // Note: nv_persist() only writes values that have changed
+    }
+    for (uint8_t r=0; r<MESH_ROWS_MAX; r++) {
+        for (uint8_t c=0; c<MESH_COLUMNS_MAX; c++) {
+            sprintf((char *)nv.token, "mh%d%d", r, c);
+            nv.index = nv_get_index((const char *)"", nv.token);
+            nv_persist(&nv);
+        }
+    }
+}
+
+/***********************************************************************************
+ * CONFIGURATION AND INTERFACE FUNCTIONS
+ * Functions to get and set variables from the cfgArray table
+ ***********************************************************************************/
+
+/*
+ * mp_get_mshe() - get height map compensation enable
+ * mp_set_mshe() - set height map compensation enable
+ * mp_get_msho() - get grid origin in X (mshx) or Y (mshy)
+ * mp_set_msho() - set grid origin in X (mshx) or Y (mshy)
+ * mp_get_mshd() - get grid spacing in X (mshdx) or Y (mshdy)
+ * mp_set_mshd() - set grid spacing in X (mshdx) or Y (mshdy)
+ * mp_get_mshc() - get number of grid columns
+ * mp_set_mshc() - set number of grid columns
+ * mp_get_mshr() - get number of grid rows
+ * mp_set_mshr() - set number of grid rows
+ * mp_get_mh()   - get height of a grid point - mhRC for row R, column C
+ * mp_set_mh()   - set height of a grid point
+ */
+
+static uint8_t _xy(const nvObj_t *nv)   // 0 for X, 1 for Y from the last character of the token
+{
+    const char *token = cfgArray[nv->index].token;
+    return ((token[strlen(token)-1] == 'y') ? 1 : 0);
+}
+
+static float &_mh(const nvObj_t *nv)    // grid point from the mhRC token
+{
+    const char *token = cfgArray[nv->index].token;
+    return (mh.height[token[2]-'0'][token[3]-'0']);
+}
+
+stat_t mp_get_mshe(nvObj_t *nv) { return (get_boolean(nv, mh.enable)); }
+stat_t mp_set_mshe(nvObj_t *nv)
+{
+    if (_locked()) {
+        return (STAT_COMMAND_NOT_ACCEPTED);
+    }
+    float offset = _offset();
+    ritorno(set_boolean(nv, mh.enable));
+    _update();
+    _resync(offset);
+    return (STAT_OK);
+}
+
+stat_t mp_get_msho(nvObj_t *nv) { return (get_float(nv, mh.origin[_xy(nv)])); }
+stat_t mp_set_msho(nvObj_t *nv)
+{
+    if (_locked()) {
+        return (STAT_COMMAND_NOT_ACCEPTED);
+    }
+    float offset = _offset();
+    ritorno(set_float(nv, mh.origin[_xy(nv)]));
+    _update();
+    _resync(offset);
+    return (STAT_OK);
+}
+
+stat_t mp_get_mshd(nvObj_t *nv) { return (get_float(nv, mh.spacing[_xy(nv)])); }
+stat_t mp_set_mshd(nvObj_t *nv)
+{
+    if (_locked()) {
+        return (STAT_COMMAND_NOT_ACCEPTED);
+    }
+    float offset = _offset();
+    ritorno(set_float(nv, mh.spacing[_xy(nv)]));
+    _update();
+    _resync(offset);
+    return (STAT_OK);
+}
+
+stat_t mp_get_mshc(nvObj_t *nv) { return (get_integer(nv, mh.columns)); }
+stat_t mp_set_mshc(nvObj_t *nv)
+{
+    if (_locked()) {
+        return (STAT_COMMAND_NOT_ACCEPTED);
+    }
+    float offset = _offset();
+    ritorno(set_integer(nv, mh.columns, 2, MESH_COLUMNS_MAX));
+    _update();
+    _resync(offset);
+    return (STAT_OK);
+}
+
+stat_t mp_get_mshr(nvObj_t *nv) { return (get_integer(nv, mh.rows)); }
+stat_t mp_set_mshr(nvObj_t *nv)
+{
+    if (_locked()) {
+        return (STAT_COMMAND_NOT_ACCEPTED);
+    }
+    float offset = _offset();
+    ritorno(set_integer(nv, mh.rows, 2, MESH_ROWS_MAX));
+    _update();
+    _resync(offset);
+    return (STAT_OK);
+}
+
+stat_t mp_get_mh(nvObj_t *nv) { return (get_float(nv, _mh(nv))); }
+stat_t mp_set_mh(nvObj_t *nv)
+{
+    if (_locked()) {
+        return (STAT_COMMAND_NOT_ACCEPTED);
+    }
+    float offset = _offset();
+    ritorno(set_float(nv, _mh(nv)));
+    _update();
+    _resync(offset);
+    return (STAT_OK);
+}
+
+/***********************************************************************************
+ * TEXT MODE SUPPORT
+ * Functions to print variables from the cfgArray table
+ ***********************************************************************************/
+
+#ifdef __TEXT_MODE
+
+static const char fmt_mshe[]  = "[mshe]  height map compensation%6d [0=off,1=on]\n";
+static const char fmt_mshx[]  = "[mshx]  height map origin X%14.3f mm\n";
+static const char fmt_mshy[]  = "[mshy]  height map origin Y%14.3f mm\n";
+static const char fmt_mshdx[] = "[mshdx] height map spacing X%13.3f mm\n";
+static const char fmt_mshdy[] = "[mshdy] height map spacing Y%13.3f mm\n";
+static const char fmt_mshc[]  = "[mshc]  height map columns%8d\n";
+static const char fmt_mshr[]  = "[mshr]  height map rows%11d\n";
+static const char fmt_mh[]    = "[%s]   height map point%17.3f mm\n";
+
+void mp_print_mshe(nvObj_t *nv)  { text_print(nv, fmt_mshe);}   // TYPE_BOOLEAN
+void mp_print_mshx(nvObj_t *nv)  { text_print(nv, fmt_mshx);}   // TYPE_FLOAT
+void mp_print_mshy(nvObj_t *nv)  { text_print(nv, fmt_mshy);}   // TYPE_FLOAT
+void mp_print_mshdx(nvObj_t *nv) { text_print(nv, fmt_mshdx);}  // TYPE_FLOAT
+void mp_print_mshdy(nvObj_t *nv) { text_print(nv, fmt_mshdy);}  // TYPE_FLOAT
+void mp_print_mshc(nvObj_t *nv)  { text_print(nv, fmt_mshc);}   // TYPE_INT
+void mp_print_mshr(nvObj_t *nv)  { text_print(nv, fmt_mshr);}   // TYPE_INT
+void mp_print_mh(nvObj_t *nv)
+{
+    sprintf(cs.out_buf, fmt_mh, cfgArray[nv->index].token, nv->value_flt);
+    xio_writeline(cs.out_buf);
+}
+
+#endif // __TEXT_MODE
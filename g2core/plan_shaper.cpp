@@ -0,0 +1,298 @@
+/*
+ * plan_shaper.cpp - input shaping for vibration suppression, and pressure advance
+ * This file is part of the g2core project
+ *
+ * Copyright (c) 2010 - 2019 Alden S. Hart, Jr.
+ * Copyright (c) 2012 - 2019 Rob Giseburt
+ *
+ * This file ("the software") is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2 as published by the
+ * Free Software Foundation. You should have received a copy of the GNU General Public
+ * License, version 2 along with the software.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, you may use this file as part of a software library without
+ * restriction. Specifically, if other files instantiate templates or use macros or
+ * inline functions from this file, or you compile this file and link it with  other
+ * files to produce an executable, this file does not by itself cause the resulting
+ * executable to be covered by the GNU General Public License. This exception does not
+ * however invalidate any other reasons why the executable file might be covered by the
+ * GNU General Public License.
+ *
+ * THE SOFTWARE IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL, BUT WITHOUT ANY
+ * WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT
+ * SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+ * OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+/* Input shaping
+ *
+ *  An input shaper replaces each commanded position with a weighted sum of that axis' recent
+ *  commanded positions, x'(t) = sum(A[i] * x(t - T[i])). The impulses (A, T) are chosen so the
+ *  vibration excited by each one cancels the others at the axis' ringing frequency:
+ *
+ *    ZV  - 2 impulses over half a ringing period. Shortest delay, needs an accurate frequency
+ *    ZVD - 3 impulses over a full period. Twice the delay, tolerates frequency error
+ *    EI  - 3 impulses over a full period, tuned to leave 5% vibration over a wider band
+ *
+ *  Shaping runs in the exec on axis positions, between the segment target computed by
+ *  _exec_aline_segment() and inverse kinematics, so it works with any kinematics and doesn't
+ *  touch planning. It delays and smooths the motion by up to one ringing period. The planner
+ *  still thinks in unshaped positions - mr->position is the commanded path and the steps
+ *  follow the shaped one.
+ *
+ *  The commanded positions are kept in a delay line sampled every SHAPER_SAMPLE_MS, however
+ *  long the segments are, and positions between samples are interpolated. The delay line is
+ *  deep enough for the longest delay the shaper and pressure advance settings allow, which
+ *  is checked at compile time, so no setting can reach past it. When the commanded position stops
+ *  changing the shaped position keeps moving for up to the shaper delay; the exec plays that
+ *  out with _exec_shaper_drain() before it stops, runs a command, or completes a feedhold.
+ *
+ *  Shaper settings changes are applied when the shaper has settled (isn't moving).
+ */
+/* Pressure advance
+ *
+ *  Extruders (the A, B and C axes in the printer configs) lag their commanded position by an
+ *  amount proportional to their velocity, as the melt has to be pressurized before it flows.
+ *  Pressure advance drives the extruder ahead of its commanded position by K seconds times its
+ *  velocity. The velocity is the average over the smoothing time (taken from the same delay
+ *  line), so the offset ramps over that time instead of jumping with each segment's velocity:
+ *
+ *      x'(t) = x(t) + K * (x(t) - x(t - smooth)) / smooth
+ *
+ *  The offset is back to zero one smoothing time after the extruder stops, which the exec plays
+ *  out the same way as the shaper delay.
+ */
+
+#include "g2core.h"
+#include "config.h"
+#include "canonical_machine.h"
+#include "planner.h"
+#include "util.h"
+
+#define SHAPER_IMPULSES 3               // the most impulses any shaper type uses
+#define SHAPER_EI_VTOL ((float)0.05)    // EI shaper vibration tolerance
+#define SHAPER_SAMPLE_TIME ((float)(SHAPER_SAMPLE_MS / 60000))  // DO NOT CHANGE - time in minutes
+
+// The longest delay is a full damped period, 1/(f * sqrt(1 - zeta^2)). With zeta <= 0.6 the
+// root is >= 0.8, so the period is at most 1/(0.8 f). The newest and oldest samples bracket
+// the ends of the delay line, so two samples are not usable for delay.
+static_assert(SHAPER_DAMPING_MAX <= 0.6, "SHAPER_DAMPING_MAX is too high for the delay line depth check");
+static_assert(1000 / (0.8 * SHAPER_FREQUENCY_MIN) <= (SHAPER_SAMPLES - 2) * SHAPER_SAMPLE_MS,
+              "SHAPER_SAMPLES is too few for SHAPER_FREQUENCY_MIN");
+static_assert(1000 * PRESSURE_ADVANCE_SMOOTH_MAX <= (SHAPER_SAMPLES - 2) * SHAPER_SAMPLE_MS,
+              "SHAPER_SAMPLES is too few for PRESSURE_ADVANCE_SMOOTH_MAX");
+
+typedef struct mpShaperAxis {           // impulses for one axis, nothing shaped if count == 0
+    uint8_t count;
+    float amplitude[SHAPER_IMPULSES];
+    float delay[SHAPER_IMPULSES];       // in minutes, to match segment times
+    float advance_gain;                 // pressure advance K / smooth time, 0 if not advanced
+    float advance_delay;                // pressure advance smooth time in minutes
+} mpShaperAxis_t;
+
+typedef struct mpShaper {
+    mpShaperAxis_t a[AXES];
+    float delay_max;                    // longest delay of any axis - 0 if none are shaped or advanced
+    bool config_changed;                // rebuild the impulses when settled
+
+    bool settled;                       // shaped position is the commanded position
+    float still_time;                   // time the commanded position hasn't changed (minutes)
+
+    float position[AXES];               // shaped position at the start of the segment
+    float target[AXES];                 // shaped position at the end of the segment
+
+    // delay line - the newest sample is at head
+    uint8_t head;
+    uint8_t count;
+    float age;                          // time from the newest sample to the last segment end (minutes)
+    float last[AXES];                   // commanded position at the last segment end
+    float sample[SHAPER_SAMPLES][AXES]; // commanded positions every SHAPER_SAMPLE_TIME
+} mpShaper_t;
+
+static mpShaper_t sh;
+
+/*
+ * _build_axis() - compute the impulses for one axis from its settings
+ */
+
+static void _build_axis(mpShaperAxis_t *s, const cfgAxis_t *a)
+{
+    s->advance_gain = 0;
+    s->advance_delay = 0;
+    if ((a->pressure_advance > EPSILON) && (a->pressure_advance_smooth > EPSILON)) {
+        s->advance_gain = a->pressure_advance / a->pressure_advance_smooth;
+        s->advance_delay = a->pressure_advance_smooth / 60;
+    }
+
+    s->count = 0;
+    if ((a->shaper_type == SHAPER_NONE) || (a->shaper_frequency < EPSILON)) {
+        return;
+    }
+    float zeta = a->shaper_damping;
+    float damped = sqrt(1 - zeta*zeta);
+    float k = exp(-zeta * M_PI / damped);
+    float period = 1 / (a->shaper_frequency * damped) / 60;    // damped ringing period, in minutes
+
+    if (a->shaper_type == SHAPER_ZV) {
+        s->count = 2;
+        s->amplitude[0] = 1;
+        s->amplitude[1] = k;
+    } else if (a->shaper_type == SHAPER_ZVD) {
+        s->count = 3;
+        s->amplitude[0] = 1;
+        s->amplitude[1] = 2*k;
+        s->amplitude[2] = k*k;
+    } else {    // SHAPER_EI
+        s->count = 3;
+        s->amplitude[0] = 0.25 * (1 + SHAPER_EI_VTOL);
+        s->amplitude[1] = 0.50 * (1 - SHAPER_EI_VTOL) * k;
+        s->amplitude[2] = s->amplitude[0] * k*k;
+    }
+    float sum = 0;
+    for (uint8_t i=0; i<s->count; i++) {
+        sum += s->amplitude[i];
+    }
+    for (uint8_t i=0; i<s->count; i++) {
+        s->amplitude[i] /= sum;
+        s->delay[i] = period * 0.5 * i;
+    }
+}
+
+/*
+ * _rebuild() - apply shaper settings and restart the delay line at the given position
+ */
+
+static void _rebuild(const float position[])
+{
+    sh.delay_max = 0;
+    for (uint8_t axis=0; axis<AXES; axis++) {
+        _build_axis(&sh.a[axis], &cm->a[axis]);
+        if (sh.a[axis].count) {
+            sh.delay_max = std::max(sh.delay_max, sh.a[axis].delay[sh.a[axis].count-1]);
+        }
+        sh.delay_max = std::max(sh.delay_max, sh.a[axis].advance_delay);
+    }
+    sh.config_changed = false;
+    sh.settled = true;
+    sh.still_time = 0;
+    sh.head = 0;
+    sh.count = 1;                       // it's been at position all along, as far as the shaper can tell
+    sh.age = 0;
+    copy_vector(sh.last, position);
+    copy_vector(sh.sample[0], position);
+    copy_vector(sh.position, position);
+    copy_vector(sh.target, position);
+}
+
+/*
+ * _add_segment() - add the samples that fall within a segment ending at target
+ */
+
+static void _add_segment(const float target[], const float segment_time)
+{
+    float t = SHAPER_SAMPLE_TIME - sh.age;          // time of the next sample into the segment
+    while (t <= segment_time) {
+        float fraction = t / segment_time;
+        sh.head = (sh.head == SHAPER_SAMPLES-1) ? 0 : sh.head+1;
+        if (sh.count < SHAPER_SAMPLES) {
+            sh.count++;
+        }
+        for (uint8_t axis=0; axis<AXES; axis++) {
+            sh.sample[sh.head][axis] = sh.last[axis] + (target[axis] - sh.last[axis]) * fraction;
+        }
+        t += SHAPER_SAMPLE_TIME;
+    }
+    sh.age = segment_time - (t - SHAPER_SAMPLE_TIME);
+    copy_vector(sh.last, target);
+}
+
+/*
+ * _delayed_position() - return an axis' commanded position at delay before the last segment end
+ *
+ *  Samples older than the delay line are the oldest sample - they only run out right after
+ *  _rebuild(), when the position hadn't been changing.
+ */
+
+static float _delayed_position(const uint8_t axis, const float delay)
+{
+    if (delay < sh.age) {                           // between the last segment end and the newest sample
+        return (sh.last[axis] + (sh.sample[sh.head][axis] - sh.last[axis]) * (delay / sh.age));
+    }
+    float samples = (delay - sh.age) / SHAPER_SAMPLE_TIME;
+    uint8_t n = (uint8_t)samples;
+    if (n+1 >= sh.count) {
+        n = sh.count-1;
+        return (sh.sample[(sh.head + SHAPER_SAMPLES - n) % SHAPER_SAMPLES][axis]);
+    }
+    uint8_t i = (sh.head + SHAPER_SAMPLES - n) % SHAPER_SAMPLES;
+    uint8_t older = (i == 0) ? SHAPER_SAMPLES-1 : i-1;
+    return (sh.sample[i][axis] + (sh.sample[older][axis] - sh.sample[i][axis]) * (samples - n));
+}
+
+/*
+ * mp_shaper_init()            - set the shaper to the runtime position
+ * mp_shaper_config_changed()  - shaper settings changed, apply them when it's safe to
+ * mp_shaper_is_settled()      - true if the shaped position has caught up with the runtime
+ * mp_shaper_position()        - shaped position at the start of the segment from mp_shape_segment()
+ * mp_shape_segment()          - return the shaped target for a segment ending at target
+ *
+ *  mp_shaper_init() is used any time the steps are set to the runtime position, as that
+ *  position is then where the tool is.
+ *
+ *  mp_shape_segment() is called exactly once per segment with the commanded target and
+ *  segment time. Unshaped axes are passed through.
+ */
+
+void mp_shaper_init(const float position[]) { _rebuild(position); }
+void mp_shaper_config_changed() { sh.config_changed = true; }
+bool mp_shaper_is_settled() { return (sh.settled || fp_ZERO(sh.delay_max)); }
+const float *mp_shaper_position() { return (sh.position); }
+
+const float *mp_shape_segment(const float target[], const float segment_time)
+{
+    copy_vector(sh.position, sh.target);
+
+    if (sh.config_changed && (sh.settled || fp_ZERO(sh.delay_max))) {
+        _rebuild(sh.position);
+    }
+    if (fp_ZERO(sh.delay_max)) {        // nothing is shaped or advanced
+        sh.settled = true;
+        copy_vector(sh.target, target);
+        return (sh.target);
+    }
+
+    // add the target to the delay line
+    bool moved = false;
+    for (uint8_t axis=0; axis<AXES; axis++) {
+        if (target[axis] != sh.last[axis]) {
+            moved = true;
+            break;
+        }
+    }
+    _add_segment(target, segment_time);
+
+    // settled once every impulse sees the same position
+    sh.still_time = moved ? 0 : sh.still_time + segment_time;
+    sh.settled = (sh.still_time >= sh.delay_max);
+    if (sh.settled) {
+        copy_vector(sh.target, target);
+        return (sh.target);
+    }
+
+    for (uint8_t axis=0; axis<AXES; axis++) {
+        mpShaperAxis_t *s = &sh.a[axis];
+        float shaped = target[axis];
+        if (s->count) {
+            shaped = s->amplitude[0] * target[axis];            // first impulse is never delayed
+            for (uint8_t i=1; i<s->count; i++) {
+                shaped += s->amplitude[i] * _delayed_position(axis, s->delay[i]);
+            }
+        }
+        if (s->advance_gain > 0) {
+            shaped += s->advance_gain * (target[axis] - _delayed_position(axis, s->advance_delay));
+        }
+        sh.target[axis] = shaped;
+    }
+    return (sh.target);
+}
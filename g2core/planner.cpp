@@ -233,7 +233,11 @@ void mp_set_steps_to_runtime_position()
         mr->following_error[motor] = 0;
         st_pre.mot[motor].corrected_steps = 0;
     }
-    kn->sync_encoders(mr->encoder_steps, mr->position);
+    en_sync_external_encoders();
+    float compensated[AXES];                            // the steps are at the compensated position
+    mp_mesh_compensate(mr->position, compensated);
+    mp_shaper_init(compensated);
+    kn->sync_encoders(mr->encoder_steps, compensated);
 }
 
 
@@ -262,7 +266,7 @@ stat_t mp_set_target_steps(const float target_steps[MOTORS])
         mr->target_steps[m] = target_steps[m];               // set the new target
         mp_travel_steps[m] = mr->target_steps[m] - mr->position_steps[m];
         mr->encoder_steps[m] = en_read_encoder(m);           // get current encoder position (time aligns to commanded_steps)
-        mr->following_error[m] = mr->encoder_steps[m] - mr->commanded_steps[m];
+        mr->following_error[m] = en_following_error(m, mr->encoder_steps[m] - mr->commanded_steps[m]);
     }
 
     return st_prep_line(mr->segment_velocity, mr->target_velocity, mp_travel_steps, mr->following_error, mr->segment_time);
@@ -283,7 +287,7 @@ stat_t mp_set_target_steps(const float target_steps[MOTORS], const float start_v
         mr->target_steps[m] = target_steps[m];               // set the new target
         mp_travel_steps[m] = mr->target_steps[m] - mr->position_steps[m];
         mr->encoder_steps[m] = en_read_encoder(m);           // get current encoder position (time aligns to commanded_steps)
-        mr->following_error[m] = mr->encoder_steps[m] - mr->commanded_steps[m];
+        mr->following_error[m] = en_following_error(m, mr->encoder_steps[m] - mr->commanded_steps[m]);
     }
 
     return st_prep_line(start_velocities, end_velocities, mp_travel_steps, mr->following_error, mr->segment_time);
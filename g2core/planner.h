@@ -197,6 +197,13 @@ typedef enum {
     BLOCK_ACTIVE                    // run state
 } blockState;
 
+typedef enum {                      // input shaper types (see plan_shaper.cpp)
+    SHAPER_NONE = 0,                // axis is not shaped
+    SHAPER_ZV,                      // zero vibration
+    SHAPER_ZVD,                     // zero vibration and derivative
+    SHAPER_EI                       // extra insensitive
+} mpShaperType;
+
 typedef enum {
     SECTION_HEAD = 0,               // acceleration
     SECTION_BODY,                   // cruise
@@ -257,6 +264,18 @@ typedef enum {                      // code blocks for planning and trapezoid ge
 #define MIN_BLOCK_TIME              ((float)(MIN_BLOCK_MS / 60000))         // DO NOT CHANGE - time in minutes
 #define PHAT_CITY_TIME              ((float)(PHAT_CITY_MS / 60000))         // DO NOT CHANGE - time in minutes
 
+#define SHAPER_SAMPLE_MS            (1.0)               // input shaping delay line sample interval
+#define SHAPER_SAMPLES              128                 // delay line samples - must cover the longest shaper or smooth time
+#define SHAPER_FREQUENCY_MIN        (10.0)              // Hz - lower frequencies need more history than is kept
+#define SHAPER_FREQUENCY_MAX        (500.0)             // Hz
+#define SHAPER_DAMPING_MAX          (0.5)               // damping ratio
+#define PRESSURE_ADVANCE_MAX        (1.0)               // seconds
+#define PRESSURE_ADVANCE_SMOOTH_MIN (0.005)             // seconds
+#define PRESSURE_ADVANCE_SMOOTH_MAX (0.1)               // seconds - limited by SHAPER_SAMPLES
+
+#define MESH_COLUMNS_MAX            8                   // height map grid points along X - must agree with the mh tokens
+#define MESH_ROWS_MAX               8                   // height map grid points along Y - must agree with the mh tokens
+
 #define FEED_OVERRIDE_ENABLE        false               // initial value
 #define FEED_OVERRIDE_MIN           (0.05)              // 5% minimum
 #define FEED_OVERRIDE_MAX           (2.00)              // 200% maximum
@@ -700,6 +719,7 @@ bool mp_free_run_buffer(void)  HOT_FUNC;
 //**** plan_line.c functions
 void mp_zero_segment_velocity(void);                    // getters and setters...
 float mp_get_runtime_velocity(void);
+float mp_get_runtime_axis_velocity(const uint8_t axis);
 float mp_get_runtime_absolute_position(mpPlannerRuntime_t *_mr, uint8_t axis);
 float mp_get_runtime_display_position(uint8_t axis);
 void mp_set_runtime_display_offset(float offset[]);
@@ -707,6 +727,8 @@ bool mp_get_runtime_busy(void);
 bool mp_runtime_is_idle(void);
 
 stat_t mp_aline(GCodeState_t *_gm);                   // line planning...
+float mp_get_jerk(const float unit[], const cmMotionProfile motion_profile);
+float mp_get_stopping_length(const float velocity, const float jerk);
 void mp_plan_block_list(void);
 void mp_plan_block_forward(mpBuf_t *bf);
 
@@ -728,6 +750,53 @@ stat_t mp_exec_move(void);
 stat_t mp_exec_aline(mpBuf_t *bf);
 void mp_exit_hold_state(void);
 
+//**** plan_shaper.cpp functions
+void mp_shaper_init(const float position[]);
+void mp_shaper_config_changed(void);
+bool mp_shaper_is_settled(void);
+const float *mp_shaper_position(void);
+const float *mp_shape_segment(const float target[], const float segment_time);
+
+//**** plan_mesh.cpp functions
+void mp_mesh_compensate(const float position[], float compensated[]);
+void mp_mesh_uncompensate(float position[]);
+void mp_mesh_start(const float origin[], const float spacing[], const uint8_t columns, const uint8_t rows);
+void mp_mesh_set_height(const uint8_t column, const uint8_t row, const float height);
+void mp_mesh_finish(const bool succeeded);
+
+stat_t mp_get_mshe(nvObj_t *nv);
+stat_t mp_set_mshe(nvObj_t *nv);
+stat_t mp_get_msho(nvObj_t *nv);
+stat_t mp_set_msho(nvObj_t *nv);
+stat_t mp_get_mshd(nvObj_t *nv);
+stat_t mp_set_mshd(nvObj_t *nv);
+stat_t mp_get_mshc(nvObj_t *nv);
+stat_t mp_set_mshc(nvObj_t *nv);
+stat_t mp_get_mshr(nvObj_t *nv);
+stat_t mp_set_mshr(nvObj_t *nv);
+stat_t mp_get_mh(nvObj_t *nv);
+stat_t mp_set_mh(nvObj_t *nv);
+
+#ifdef __TEXT_MODE
+    void mp_print_mshe(nvObj_t *nv);
+    void mp_print_mshx(nvObj_t *nv);
+    void mp_print_mshy(nvObj_t *nv);
+    void mp_print_mshdx(nvObj_t *nv);
+    void mp_print_mshdy(nvObj_t *nv);
+    void mp_print_mshc(nvObj_t *nv);
+    void mp_print_mshr(nvObj_t *nv);
+    void mp_print_mh(nvObj_t *nv);
+#else
+    #define mp_print_mshe tx_print_stub
+    #define mp_print_mshx tx_print_stub
+    #define mp_print_mshy tx_print_stub
+    #define mp_print_mshdx tx_print_stub
+    #define mp_print_mshdy tx_print_stub
+    #define mp_print_mshc tx_print_stub
+    #define mp_print_mshr tx_print_stub
+    #define mp_print_mh tx_print_stub
+#endif // __TEXT_MODE
+
 void mp_dump_planner(mpBuf_t *bf_start);
 
 #endif    // End of include Guard: PLANNER_H_ONCE
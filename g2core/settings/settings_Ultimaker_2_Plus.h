@@ -382,8 +382,8 @@ M100.1 ({{ajh:144000.0}})
 
     #define TEMPERATURE_SENSOR_1_CIRCUIT_TYPE ADCCircuitRawResistance
     #define TEMPERATURE_SENSOR_1_CIRCUIT_INIT { }
-    #define TEMPERATURE_SENSOR_1_TYPE  PT100<MAX31865<SPIBus_used_t::SPIBusDevice>>
-    #define TEMPERATURE_SENSOR_1_INIT {&temperature_sensor_1_circuit, spiBus, spiCSPinMux.getCS(5), /*pullup_resistance:*/ 430.0f}
+    #define TEMPERATURE_SENSOR_1_TYPE  PT100<MAX31865<SPIScheduler_used_t::Device_t>>
+    #define TEMPERATURE_SENSOR_1_INIT {&temperature_sensor_1_circuit, spiScheduler.bus(kSPIPriorityThermal), spiCSPinMux.getCS(5), /*pullup_resistance:*/ 430.0f}
 #endif // HAS_TEMPERATURE_SENSOR_1
 
 #define EXTRUDER_1_OUTPUT_PIN kHeaterOutput1_PinNumber
@@ -398,8 +398,8 @@ M100.1 ({{ajh:144000.0}})
 
     // #define TEMPERATURE_SENSOR_2_CIRCUIT_TYPE ADCCircuitRawResistance
     // #define TEMPERATURE_SENSOR_2_CIRCUIT_INIT { /*pullup_resistance:*/ 430 }
-    // #define TEMPERATURE_SENSOR_2_TYPE  PT100<MAX31865<SPIBus_used_t::SPIBusDevice>>
-    // #define TEMPERATURE_SENSOR_2_INIT {/*pullup_resistance:*/ 430, /*inline_resistance*/0, spiBus, spiCSPinMux.getCS(5)}
+    // #define TEMPERATURE_SENSOR_2_TYPE  PT100<MAX31865<SPIScheduler_used_t::Device_t>>
+    // #define TEMPERATURE_SENSOR_2_INIT {/*pullup_resistance:*/ 430, /*inline_resistance*/0, spiScheduler.bus(kSPIPriorityThermal), spiCSPinMux.getCS(5)}
 #endif // HAS_TEMPERATURE_SENSOR_2
 
 #define EXTRUDER_2_OUTPUT_PIN kHeaterOutput2_PinNumber
@@ -413,8 +413,8 @@ M100.1 ({{ajh:144000.0}})
 
     #define TEMPERATURE_SENSOR_3_CIRCUIT_TYPE ADCCircuitRawResistance
     #define TEMPERATURE_SENSOR_3_CIRCUIT_INIT { }
-    #define TEMPERATURE_SENSOR_3_TYPE  PT100<MAX31865<SPIBus_used_t::SPIBusDevice>>
-    #define TEMPERATURE_SENSOR_3_INIT {&temperature_sensor_3_circuit, spiBus, spiCSPinMux.getCS(6), /*pullup_resistance:*/ 430.0f}
+    #define TEMPERATURE_SENSOR_3_TYPE  PT100<MAX31865<SPIScheduler_used_t::Device_t>>
+    #define TEMPERATURE_SENSOR_3_INIT {&temperature_sensor_3_circuit, spiScheduler.bus(kSPIPriorityThermal), spiCSPinMux.getCS(6), /*pullup_resistance:*/ 430.0f}
 #endif // HAS_TEMPERATURE_SENSOR_3
 
 #define BED_OUTPUT_PIN kHeaterOutput11_PinNumber
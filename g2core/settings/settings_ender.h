@@ -324,8 +324,8 @@
 #else
     // #define TEMPERATURE_SENSOR_1_TYPE  PT100<ADCDifferentialPair<Motate::kADC1_Neg_PinNumber, kADC1_Pos_PinNumber>>
     // #define TEMPERATURE_SENSOR_1_INIT {/*pullup_resistance:*/ 2000, /*inline_resistance*/0.0}
-   #define TEMPERATURE_SENSOR_1_TYPE  PT100<MAX31865<SPIBus_used_t::SPIBusDevice>>
-   #define TEMPERATURE_SENSOR_1_INIT {/*pullup_resistance:*/ 430, /*inline_resistance*/0, spiBus, spiCSPinMux.getCS(5)}
+   #define TEMPERATURE_SENSOR_1_TYPE  PT100<MAX31865<SPIScheduler_used_t::Device_t>>
+   #define TEMPERATURE_SENSOR_1_INIT {/*pullup_resistance:*/ 430, /*inline_resistance*/0, spiScheduler.bus(kSPIPriorityThermal), spiCSPinMux.getCS(5)}
 #endif // 0 or 1
 #endif // HAS_TEMPERATURE_SENSOR_1
 
@@ -343,8 +343,8 @@
 #else
     #define TEMPERATURE_SENSOR_2_TYPE  PT100<ADCDifferentialPair<Motate::kADC2_Neg_PinNumber, kADC2_Pos_PinNumber>>
     #define TEMPERATURE_SENSOR_2_INIT {/*pullup_resistance:*/ 200, /*inline_resistance*/0.0}
-//    #define TEMPERATURE_SENSOR_2_TYPE  PT100<MAX31865<SPIBus_used_t::SPIBusDevice>>
-//    #define TEMPERATURE_SENSOR_2_INIT {/*pullup_resistance:*/ 430, /*inline_resistance*/0, spiBus, spiCSPinMux.getCS(5)}
+//    #define TEMPERATURE_SENSOR_2_TYPE  PT100<MAX31865<SPIScheduler_used_t::Device_t>>
+//    #define TEMPERATURE_SENSOR_2_INIT {/*pullup_resistance:*/ 430, /*inline_resistance*/0, spiScheduler.bus(kSPIPriorityThermal), spiCSPinMux.getCS(5)}
 #endif // 0 or 1
 #endif // HAS_TEMPERATURE_SENSOR_2
 
@@ -361,8 +361,8 @@
 #else
     // #define TEMPERATURE_SENSOR_3_TYPE  PT100<ADCDifferentialPair<Motate::kADC3_Neg_PinNumber, kADC3_Pos_PinNumber>>
     // #define TEMPERATURE_SENSOR_3_INIT {/*pullup_resistance:*/ 200, /*inline_resistance*/0.0}
-   #define TEMPERATURE_SENSOR_3_TYPE  PT100<MAX31865<SPIBus_used_t::SPIBusDevice>>
-   #define TEMPERATURE_SENSOR_3_INIT {/*pullup_resistance:*/ 430, /*inline_resistance*/0, spiBus, spiCSPinMux.getCS(6)}
+   #define TEMPERATURE_SENSOR_3_TYPE  PT100<MAX31865<SPIScheduler_used_t::Device_t>>
+   #define TEMPERATURE_SENSOR_3_INIT {/*pullup_resistance:*/ 430, /*inline_resistance*/0, spiScheduler.bus(kSPIPriorityThermal), spiCSPinMux.getCS(6)}
 
 #endif // 0 or 1
 #endif // HAS_TEMPERATURE_SENSOR_3
@@ -49,6 +49,7 @@
 
 #define SOFT_LIMIT_ENABLE           0                       // 0=off, 1=on
 #define HARD_LIMIT_ENABLE           0                       // 0=off, 1=on
+#define HOMING_SIMULTANEOUS         1                       // 0=one axis at a time, 1=home X and Y together
 #define SAFETY_INTERLOCK_ENABLE     1                       // 0=off, 1=on
 
 #define SPINDLE_ENABLE_POLARITY     1                       // 0=active low, 1=active high
@@ -105,6 +106,11 @@
 #define M1_POWER_MODE            MOTOR_POWER_MODE  // 1pm        TRUE=low power idle enabled
 #define M1_POWER_LEVEL           0.6
 
+// To square the gantry when homing give each Y motor its own switch: fit a second Ymin
+// switch on the other side of the gantry, wire it to a free input (e.g. the Ymax input 4,
+// in place of the Ymax switch) and set 3hi to that input and 2hi to 3. Leave them at 0 on
+// stock wiring - both motors then stop on the Y homing input. A motor whose input doesn't
+// trip fails the homing cycle.
 #define M2_MOTOR_MAP             AXIS_Y
 #define M2_STEP_ANGLE            1.8
 #define M2_TRAVEL_PER_REV        36.54
@@ -112,6 +118,7 @@
 #define M2_POLARITY              1
 #define M2_POWER_MODE            MOTOR_POWER_MODE
 #define M2_POWER_LEVEL           0.6
+#define M2_HOMING_INPUT          0
 
 #define M3_MOTOR_MAP             AXIS_Y
 #define M3_STEP_ANGLE            1.8
@@ -120,6 +127,7 @@
 #define M3_POLARITY              0
 #define M3_POWER_MODE            MOTOR_POWER_MODE
 #define M3_POWER_LEVEL           0.6
+#define M3_HOMING_INPUT          0
 
 #define M4_MOTOR_MAP             AXIS_Z
 #define M4_STEP_ANGLE            1.8
@@ -44,6 +44,7 @@
 
 #define SOFT_LIMIT_ENABLE           0       // 0=off, 1=on
 #define HARD_LIMIT_ENABLE           0       // 0=off, 1=on
+#define HOMING_SIMULTANEOUS         1       // 0=one axis at a time, 1=home X and Y together
 #define SAFETY_INTERLOCK_ENABLE     0       // 0=off, 1=on
 
 #define SPINDLE_ENABLE_POLARITY     1       // 0=active low, 1=active high
@@ -100,6 +101,7 @@
 #define M1_POLARITY                 1                   // 1po        0=normal, 1=reversed
 #define M1_POWER_MODE               MOTOR_POWER_MODE    // 1pm        TRUE=low power idle enabled
 #define M1_POWER_LEVEL              MOTOR_POWER_LEVEL   // 1pl        Irrelevant to Shopbot sbv300
+#define M1_HOMING_INPUT             1                   // 1hi        X switch, stops M1 when homing
 
 #define M2_MOTOR_MAP                AXIS_Y_EXTERNAL
 #define M2_STEP_ANGLE               1.8
@@ -108,6 +110,7 @@
 #define M2_POLARITY                 1
 #define M2_POWER_MODE               MOTOR_POWER_MODE
 #define M2_POWER_LEVEL              MOTOR_POWER_LEVEL
+#define M2_HOMING_INPUT             3                   // 2hi        Y switch, stops M2 when homing
 
 #define M3_MOTOR_MAP                AXIS_Z_EXTERNAL
 #define M3_STEP_ANGLE               1.8
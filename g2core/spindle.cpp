@@ -128,6 +128,12 @@ spDirection spindle_get_direction() {
 void spindle_engage(const GCodeState_t &gm) {
     if (active_toolhead) { active_toolhead->engage(gm); }
 }
+void spindle_engage_segment(float speed, float velocity_factor) {
+    if (active_toolhead) { active_toolhead->engage_segment(speed, velocity_factor); }
+}
+void spindle_motion_stopped() {
+    if (active_toolhead) { active_toolhead->motion_stopped(); }
+}
 
 bool is_spindle_ready_to_resume() {
     if (active_toolhead) { return active_toolhead->ready_to_resume(); }
@@ -203,6 +209,14 @@ bool is_a_toolhead_busy() {
  **** Spindle Settings ******************************************************************
  ****************************************************************************************/
 
+stat_t sp_get_spmo(nvObj_t *nv) { return (get_integer(nv, active_toolhead->get_mode())); }
+stat_t sp_set_spmo(nvObj_t *nv) {
+    uint8_t new_mode;
+    ritorno(set_integer(nv, new_mode, SPINDLE_MODE_PLAN_TO_STOP, SPINDLE_MODE_CONTINUOUS));
+    active_toolhead->set_mode((spMode)new_mode);
+    return (STAT_OK);
+}
+
 stat_t sp_get_spep(nvObj_t *nv) {
     return (get_integer(nv, active_toolhead->get_enable_polarity()));
 }
@@ -444,7 +458,7 @@ stat_t pwm_set_p1k(nvObj_t *nv) {
 
 const char fmt_spc[]  = "[spc]  spindle control:%12d [0=OFF,1=CW,2=CCW]\n";
 const char fmt_sps[]  = "[sps]  spindle speed:%14.0f rpm\n";
-const char fmt_spmo[] = "[spmo] spindle mode%16d [0=disabled,1=plan-to-stop,2=continuous]\n";
+const char fmt_spmo[] = "[spmo] spindle mode%16d [1=plan-to-stop,2=continuous]\n";
 const char fmt_spep[] = "[spep] spindle enable polarity%5d [0=active_low,1=active_high]\n";
 const char fmt_spdp[] = "[spdp] spindle direction polarity%2d [0=CW_low,1=CW_high]\n";
 const char fmt_spph[] = "[spph] spindle pause on hold%7d [0=no,1=pause_on_hold]\n";
@@ -32,14 +32,61 @@
 #include "config.h" // for configSubtable
 #include "gpio.h"   // for ioPolarity
 
+#include <algorithm>
+#include <cmath>
+
 enum spDirection {                  // how spindle controls are presented by the Gcode parser
     SPINDLE_OFF = 0,            // M5
     SPINDLE_CW = 1,             // M3 and store CW to spindle.direction
     SPINDLE_CCW = 2,            // M4 and store CCW to spsindle.direction
 };
 
+enum spMode {                       // how S word changes are applied
+    SPINDLE_MODE_PLAN_TO_STOP = 1,  // queue a command - motion stops while the spindle gets to speed
+    SPINDLE_MODE_CONTINUOUS = 2,    // change speed as the move starts and ramp without stopping
+};
+
 class GCodeState_t;
 
+// speedToPhase - the curve from speed (S) to PWM phase shared by the PWM toolheads
+struct speedToPhase {
+    float speed_lo;              // minimum spindle speed [0..N]
+    float speed_hi;              // maximum spindle speed
+
+    float phase_lo;              // pwm phase at minimum spindle speed, clamped [0..1]
+    float phase_hi;              // pwm phase at maximum spindle speed, clamped [0..1]
+
+    float k_value;                  // pwm k value to control curve slope
+
+    // The power curve sampled at even steps of normalized speed. It's rebuilt when k changes,
+    // so callers running every tick or segment interpolate instead of calling pow().
+    static const uint8_t kCurveSegments = 64;
+    float curve[kCurveSegments + 1];
+
+    void set_k_value(float new_k_value) {
+        k_value = new_k_value;
+        for (uint8_t i = 0; i <= kCurveSegments; i++) {
+            curve[i] = std::pow((float)i / kCurveSegments, k_value);
+        }
+    }
+
+    // convert a speed value in the range of (speed_lo .. speed_hi)
+    // to a value in the range of (phase_lo .. phase_hi)
+    float speed_to_phase(float speed) {
+
+        // Clamp speed to the [speed_lo, speed_hi] range
+        speed = (std::max(speed_lo, std::min(speed_hi, speed)) - speed_lo) / (speed_hi - speed_lo);
+
+        // Apply a power curve that weights towards phase_low
+        // The exponent (k > 1) determines the curvature
+        float position = speed * kCurveSegments;
+        uint8_t i = std::min((uint8_t)position, (uint8_t)(kCurveSegments - 1));
+        float curved_speed = curve[i] + (curve[i + 1] - curve[i]) * (position - i);
+
+        return (curved_speed * (phase_hi - phase_lo)) + phase_lo;
+    }
+};
+
 class ToolHead  // TODO: Move to a toolhead file
 {
    public:
@@ -82,6 +129,17 @@ class ToolHead  // TODO: Move to a toolhead file
     // called from the loader right before a move, with the gcode model to use
     virtual void engage(const GCodeState_t &gm);
 
+    // called from the loader right before each segment of a move, with the S word of that move
+    // and the segment's velocity as a fraction of the move's cruise velocity (0 for traverses)
+    virtual void engage_segment(float speed, float velocity_factor) { /* do nothing */ }
+
+    // called from the loader when it has no segment to run - motion has stopped, or a dwell or command is next
+    virtual void motion_stopped() { /* do nothing */ }
+
+    // how S word changes are applied - toolheads that can't ramp under motion ignore this
+    virtual void set_mode(spMode new_mode) { /* do nothing */ }
+    virtual spMode get_mode() { return SPINDLE_MODE_PLAN_TO_STOP; }
+
     virtual bool is_on();     // return if the current direction is anything but OFF, **even if paused**
 
     // support for legacy interfaces, overriding is optional
@@ -158,6 +216,8 @@ stat_t spindle_set_direction(spDirection direction);  // M3/M4/M5 - returns STAT
 spDirection spindle_get_direction();                  // return if any fo M3/M4/M5 are active (actual, not gcode model)
 
 void spindle_engage(const GCodeState_t &gm);          // called from the loader right before a move, with the gcode model to use
+void spindle_engage_segment(float speed, float velocity_factor); // called from the loader right before each segment
+void spindle_motion_stopped();                        // called from the loader when there is no segment to run
 
 bool is_spindle_ready_to_resume();  // if the spindle can resume at this time, return true
 bool is_spindle_on_or_paused();     // returns if the spindle is on or paused - IOW would it try to resume from feedhold
@@ -167,6 +227,8 @@ bool is_a_toolhead_busy();          // returns true if motion should continue to
 // void spindle_start_override(const float ramp_time, const float override_factor);
 // void spindle_end_override(const float ramp_time);
 
+stat_t sp_get_spmo(nvObj_t *nv);
+stat_t sp_set_spmo(nvObj_t *nv);
 stat_t sp_get_spep(nvObj_t *nv);
 stat_t sp_set_spep(nvObj_t *nv);
 stat_t sp_get_spdp(nvObj_t *nv);
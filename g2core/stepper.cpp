@@ -111,6 +111,22 @@ http://www.cprogramming.com/c++11/c++11-lambda-closures.html
 http://en.cppreference.com/w/cpp/language/lambda
 */
 
+// SysTickEvent that asks each driver for its status in turn (see DRIVER_STATUS_INTERVAL_MS)
+static uint8_t driver_status_motor = 0;
+static uint8_t driver_status_countdown = DRIVER_STATUS_INTERVAL_MS;
+Motate::SysTickEvent driver_status_systick_event{
+    [] {
+        if (--driver_status_countdown != 0) {
+            return;
+        }
+        driver_status_countdown = DRIVER_STATUS_INTERVAL_MS;
+        Motors[driver_status_motor]->requestStatus();
+        if (++driver_status_motor == MOTORS) {
+            driver_status_motor = 0;
+        }
+    },
+    nullptr};
+
 /************************************************************************************
  **** CODE **************************************************************************
  ************************************************************************************/
@@ -162,7 +178,9 @@ void stepper_init()
     // setup motor power levels and apply power level to stepper drivers
     for (uint8_t motor=0; motor<MOTORS; motor++) {
         Motors[motor]->setPowerLevels(st_cfg.mot[motor].power_level, st_cfg.mot[motor].power_level_idle);
+        Motors[motor]->setStallInput(STALL_INPUT(motor));
     }
+    SysTickTimer.registerEvent(&driver_status_systick_event);
 
     dda_timer.start();                          // start the DDA timer if not already running
 }
@@ -176,7 +194,10 @@ void stepper_init()
 void stepper_reset()
 {
     dda_timer.stop();                                   // stop all movement
+    __disable_irq();                                    // see st_get_dda_ticks()
+    st_run.dda_ticks_end -= st_run.dda_ticks_downcount; // the tick count stops where it is
     st_run.dda_ticks_downcount = 0;                     // signal the runtime is not busy
+    __enable_irq();
     st_run.dwell_ticks_downcount = 0;
     st_pre.buffer_state = PREP_BUFFER_OWNED_BY_EXEC;    // set to EXEC or it won't restart
 
@@ -226,6 +247,63 @@ bool st_runtime_isbusy()
     return (st_run.dda_ticks_downcount || st_run.dwell_ticks_downcount || is_a_toolhead_busy());
 }
 
+/*
+ * st_get_dda_ticks()     - return the number of DDA ticks run, wrapping at 2^32
+ * st_get_substep_phase() - return how far a motor's DDA is toward its next step (0 to 1)
+ * st_get_step_rate()     - return a motor's steps per DDA tick in the current segment
+ *
+ *  These give the motor position between counted steps, and let a position read now be
+ *  extrapolated back to an earlier DDA tick (see en_take_encoder_snapshot()). The tick count
+ *  only advances while segments are running, and is kept per segment so the DDA interrupt
+ *  doesn't have to count it. The tick count is read with interrupts masked so the end and the
+ *  downcount always belong to the same segment. The DDA interrupt can still preempt callers
+ *  between calls, so a caller that reads several of these re-reads the tick count to check
+ *  that the DDA didn't tick in between.
+ */
+
+uint32_t st_get_dda_ticks()
+{
+    __disable_irq();                                    // the end and downcount must be from the same segment
+    uint32_t ticks = st_run.dda_ticks_end - st_run.dda_ticks_downcount;
+    __enable_irq();
+    return (ticks);
+}
+
+float st_get_substep_phase(const uint8_t motor)
+{
+    float phase = 1 + ((float)st_run.mot[motor].substep_accumulator / (float)DDA_SUBSTEPS);
+    return (std::max((float)0, std::min(phase, (float)1)));
+}
+
+float st_get_step_rate(const uint8_t motor)
+{
+    return ((float)st_run.mot[motor].substep_increment / (float)DDA_SUBSTEPS);
+}
+
+/*
+ * st_lock_motor()    - stop a motor now and keep it stopped until unlocked
+ * st_unlock_motors() - let all locked motors step again
+ *
+ *  Homing uses these to stop each motor on its own switch while the rest of the move carries
+ *  on. The motor stops on the next DDA tick without decelerating, and the loader keeps it from
+ *  stepping in later segments. Neither the planner nor the kinematics know, so the caller has
+ *  to set the steps to the runtime position from the encoders once the motion has stopped.
+ *  Locked motors don't count encoder steps, as they don't step.
+ *
+ *  st_lock_motor() is safe to call from interrupts, including ones that preempt the loader.
+ */
+
+void st_lock_motor(const uint8_t motor)
+{
+    __disable_irq();
+    st_run.locked_motors |= (1 << motor);
+    st_run.mot[motor].substep_increment = 0;
+    st_run.mot[motor].substep_increment_increment = 0;
+    __enable_irq();
+}
+
+void st_unlock_motors() { st_run.locked_motors = 0; }
+
 /*
  * st_clc() - clear counters
  */
@@ -489,6 +567,7 @@ static void _load_move()
 #if (MOTORS > 5)
         motor_6.motionStopped();
 #endif
+        spindle_motion_stopped();   // ...and let the toolhead know
         return;
     } // if (st_pre.buffer_state != PREP_BUFFER_OWNED_BY_LOADER)
 
@@ -496,6 +575,12 @@ static void _load_move()
     if (st_pre.bf) {
         spindle_engage(st_pre.bf->gm);
     }
+    if (st_pre.block_type == BLOCK_TYPE_ALINE) {
+        spindle_engage_segment(st_pre.spindle_speed, st_pre.velocity_factor);
+        st_pre.velocity_factor = 0;     // lines not staged by the exec (e.g. kinematics idle) don't fire a laser
+    } else {
+        spindle_motion_stopped();
+    }
 
     // handle aline loads first (most common case)
     if (st_pre.block_type == BLOCK_TYPE_ALINE) {
@@ -620,9 +705,23 @@ static void _load_move()
         ACCUMULATE_ENCODER(MOTOR_6);
 #endif
 
+        // locked motors run the segment with 0 steps (see st_lock_motor()). This is checked after
+        // the copy so a lock set by an interrupt while loading can't be overwritten by the copy.
+        if (st_run.locked_motors) {
+            for (uint8_t motor = MOTOR_1; motor < MOTORS; motor++) {
+                if (st_run.locked_motors & (1 << motor)) {
+                    st_run.mot[motor].substep_increment = 0;
+                    st_run.mot[motor].substep_increment_increment = 0;
+                }
+            }
+        }
+
         //**** do this last ****
 
+        __disable_irq();                // st_get_dda_ticks() may be called from a higher priority interrupt
+        st_run.dda_ticks_end += st_pre.dda_ticks;
         st_run.dda_ticks_downcount = st_pre.dda_ticks;
+        __enable_irq();
 
     // handle dwells and commands
     } else if (st_pre.block_type == BLOCK_TYPE_DWELL) {
@@ -643,6 +742,41 @@ static void _load_move()
     st_request_exec_move();                             // exec and prep next move
 }
 
+/*
+ * _correct_following_error() - return the correction to take out of this motor's steps
+ *
+ *  'Nudge' correction strategy. Inject a single, scaled correction value then hold off.
+ *  Motors with an external encoder use the EXTERNAL_CORRECTION settings.
+ */
+
+static float _correct_following_error(const uint8_t motor, const float steps, const float following_error)
+{
+    bool external = en_has_external_encoder(motor);
+    float threshold = external ? EXTERNAL_CORRECTION_THRESHOLD : STEP_CORRECTION_THRESHOLD;
+
+    if ((--st_pre.mot[motor].correction_holdoff >= 0) || (std::abs(following_error) <= threshold)) {
+        return (0);
+    }
+    float correction_steps;
+    float correction_max;
+    if (external) {
+        st_pre.mot[motor].correction_holdoff = EXTERNAL_CORRECTION_HOLDOFF;
+        correction_steps = following_error * EXTERNAL_CORRECTION_FACTOR;
+        correction_max = std::abs(steps) * EXTERNAL_CORRECTION_MAX;
+    } else {
+        st_pre.mot[motor].correction_holdoff = STEP_CORRECTION_HOLDOFF;
+        correction_steps = following_error * STEP_CORRECTION_FACTOR;
+        correction_max = std::min(std::abs(steps), STEP_CORRECTION_MAX);
+    }
+    if (correction_steps > 0) {
+        correction_steps = std::min(correction_steps, correction_max);
+    } else {
+        correction_steps = std::max(correction_steps, -correction_max);
+    }
+    st_pre.mot[motor].corrected_steps += correction_steps;
+    return (correction_steps);
+}
+
 /***********************************************************************************
  * st_prep_line() - Prepare the next move for the loader
  *
@@ -688,7 +822,6 @@ stat_t st_prep_line(const float start_velocity, const float end_velocity, const
     // this is explained later
     double t_v0_v1 = (double)st_pre.dda_ticks * (start_velocity + end_velocity);
 
-    float correction_steps;
     for (uint8_t motor=0; motor<MOTORS; motor++) {          // remind us that this is motors, not axes
         float steps = travel_steps[motor];
 
@@ -710,22 +843,8 @@ stat_t st_prep_line(const float start_velocity, const float end_velocity, const
         }
 
 
-        // 'Nudge' correction strategy. Inject a single, scaled correction value then hold off
-        // NOTE: This clause can be commented out to test for numerical accuracy and accumulating errors
-        if ((--st_pre.mot[motor].correction_holdoff < 0) &&
-            (std::abs(following_error[motor]) > STEP_CORRECTION_THRESHOLD)) {
-
-            st_pre.mot[motor].correction_holdoff = STEP_CORRECTION_HOLDOFF;
-            correction_steps = following_error[motor] * STEP_CORRECTION_FACTOR;
-
-            if (correction_steps > 0) {
-                correction_steps = std::min(std::min(correction_steps, std::abs(steps)), STEP_CORRECTION_MAX);
-            } else {
-                correction_steps = std::max(std::max(correction_steps, -std::abs(steps)), -STEP_CORRECTION_MAX);
-            }
-            st_pre.mot[motor].corrected_steps += correction_steps;
-            steps -= correction_steps;
-        }
+        // NOTE: This can be commented out to test for numerical accuracy and accumulating errors
+        steps -= _correct_following_error(motor, steps, following_error[motor]);
 
         // Compute substep increment. The accumulator must be *exactly* the incoming
         // fractional steps times the substep multiplier or positional drift will occur.
@@ -800,19 +919,26 @@ stat_t st_prep_line(const float start_velocities[], const float end_velocities[]
     //st_pre.dda_period = _f_to_period(FREQUENCY_DDA);                // FYI: this is a constant
     st_pre.dda_ticks = (int32_t)(segment_time * 60 * FREQUENCY_DDA);// NB: converts minutes to seconds
 
-    float correction_steps;
     for (uint8_t motor=0; motor<MOTORS; motor++) {          // remind us that this is motors, not axes
         float steps = travel_steps[motor];
 
-        // setup motor parameters
-        double t_v0_v1 = (double)st_pre.dda_ticks * (start_velocities[motor] + end_velocities[motor]);
-
         // Skip this motor if there are no new steps. Leave all other values intact.
         if (fp_ZERO(steps)) {
             st_pre.mot[motor].substep_increment = 0;        // substep increment also acts as a motor flag
             continue;
         }
 
+        // setup motor parameters
+        // A motor can have steps but no velocity of its own if its offset moved (e.g. an encoder sync).
+        // Play those steps out at a constant rate - only the ratio of the velocities matters below.
+        float start_velocity = start_velocities[motor];
+        float end_velocity = end_velocities[motor];
+        if (fp_ZERO(start_velocity + end_velocity)) {
+            start_velocity = 1;
+            end_velocity = 1;
+        }
+        double t_v0_v1 = (double)st_pre.dda_ticks * (start_velocity + end_velocity);
+
         // Setup the direction, compensating for polarity.
         // Set the step_sign which is used by the stepper ISR to accumulate step position
 
@@ -825,34 +951,35 @@ stat_t st_prep_line(const float start_velocities[], const float end_velocities[]
         }
 
 
-        // 'Nudge' correction strategy. Inject a single, scaled correction value then hold off
-        // NOTE: This clause can be commented out to test for numerical accuracy and accumulating errors
-        if ((--st_pre.mot[motor].correction_holdoff < 0) &&
-            (std::abs(following_error[motor]) > STEP_CORRECTION_THRESHOLD)) {
-
-            st_pre.mot[motor].correction_holdoff = STEP_CORRECTION_HOLDOFF;
-            correction_steps = following_error[motor] * STEP_CORRECTION_FACTOR;
-
-            if (correction_steps > 0) {
-                correction_steps = std::min(std::min(correction_steps, std::abs(steps)), STEP_CORRECTION_MAX);
-            } else {
-                correction_steps = std::max(std::max(correction_steps, -std::abs(steps)), -STEP_CORRECTION_MAX);
-            }
-            st_pre.mot[motor].corrected_steps += correction_steps;
-            steps -= correction_steps;
-        }
+        // NOTE: This can be commented out to test for numerical accuracy and accumulating errors
+        steps -= _correct_following_error(motor, steps, following_error[motor]);
 
         // All math is explained in the previous function
 
         double s_double = std::abs(steps * 2.0);
-        st_pre.mot[motor].substep_increment = round(((s_double * start_velocities[motor])/(t_v0_v1)) * (double)DDA_SUBSTEPS);
-        st_pre.mot[motor].substep_increment_increment = round(((s_double*(end_velocities[motor]-start_velocities[motor]))/(((double)st_pre.dda_ticks-1.0)*t_v0_v1)) * (double)DDA_SUBSTEPS);
+        st_pre.mot[motor].substep_increment = round(((s_double * start_velocity)/(t_v0_v1)) * (double)DDA_SUBSTEPS);
+        st_pre.mot[motor].substep_increment_increment = round(((s_double*(end_velocity-start_velocity))/(((double)st_pre.dda_ticks-1.0)*t_v0_v1)) * (double)DDA_SUBSTEPS);
     }
     st_pre.block_type = BLOCK_TYPE_ALINE;
     st_pre.bf = nullptr;
     st_pre.buffer_state = PREP_BUFFER_OWNED_BY_LOADER;    // signal that prep buffer is ready
     return (STAT_OK);
 }
+/*
+ * st_prep_toolhead() - Stage the toolhead values for the next prepped line
+ *
+ *  The S word of the move the line is from, and the line's velocity as a fraction of the
+ *  move's cruise velocity. The loader hands them to the toolhead as the line starts, so a
+ *  continuous mode spindle changes speed and a laser sets its power on the segment timeline
+ *  instead of from queued commands.
+ */
+
+void st_prep_toolhead(const float speed, const float velocity_factor)
+{
+    st_pre.spindle_speed = speed;
+    st_pre.velocity_factor = velocity_factor;
+}
+
 /*
  * st_prep_null() - Keeps the loader happy. Otherwise performs no action
  */
@@ -960,6 +1087,8 @@ static float _set_motor_steps_per_unit(nvObj_t *nv)
  * st_get_pm() - get motor power mode
  * st_set_pl() - set motor power level
  * st_set_pi() - set motor idle power level
+ * st_get_hi() - get motor homing input
+ * st_set_hi() - set motor homing input
  */
 
 /*
@@ -1136,6 +1265,18 @@ stat_t st_set_pi(nvObj_t *nv) {
     return (STAT_OK);
 }
 
+/*
+ * st_get_hi() - get motor homing input
+ * st_set_hi() - set motor homing input
+ *
+ *  A motor with its own homing input is stopped by that input when its axis is homed, and
+ *  the others on the axis carry on to theirs - this is how a dual motor gantry is squared.
+ *  Like the axis homing input it can be a switch or the motor's STALL_INPUT(). 0 (the default)
+ *  stops the motor with the rest of its axis, on the axis' homing input.
+ */
+stat_t st_get_hi(nvObj_t *nv) { return(get_integer(nv, st_cfg.mot[_motor(nv->index)].homing_input)); }
+stat_t st_set_hi(nvObj_t *nv) { return(set_integer(nv, st_cfg.mot[_motor(nv->index)].homing_input, 0, STALL_INPUT(MOTORS-1))); }
+
 /*
  * st_get_pwr()	- get current motor power
  *
@@ -1298,6 +1439,7 @@ static const char fmt_0sp[] = "[%s%s] m%s step polarity%13d [0=active HIGH,1=act
 static const char fmt_0pm[] = "[%s%s] m%s power management%10d [0=disabled,1=always on,2=in cycle,3=when moving,4=reduced when idle]\n";
 static const char fmt_0pl[] = "[%s%s] m%s motor power level%13.3f [0.000=minimum, 1.000=maximum]\n";
 static const char fmt_0pi[] = "[%s%s] m%s motor idle power level%13.3f [0.000=minimum, 1.000=maximum]\n";
+static const char fmt_0hi[] = "[%s%s] m%s homing input%12d [input 1-N or 0 to use the axis homing input]\n";
 static const char fmt_pwr[] = "[%s%s] Motor %c power level:%12.3f\n";
 
 void st_print_me(nvObj_t *nv) { text_print(nv, fmt_me);}    // TYPE_NULL - message only
@@ -1339,6 +1481,7 @@ void st_print_sp(nvObj_t *nv) { _print_motor_int(nv, fmt_0sp);}
 void st_print_pm(nvObj_t *nv) { _print_motor_int(nv, fmt_0pm);}
 void st_print_pl(nvObj_t *nv) { _print_motor_flt(nv, fmt_0pl);}
 void st_print_pi(nvObj_t *nv) { _print_motor_flt(nv, fmt_0pi);}
+void st_print_hi(nvObj_t *nv) { _print_motor_int(nv, fmt_0hi);}
 void st_print_pwr(nvObj_t *nv){ _print_motor_pwr(nv, fmt_pwr);}
 
 #endif // __TEXT_MODE
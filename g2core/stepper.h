@@ -322,6 +322,28 @@ enum stPowerMode {
 #define STEP_CORRECTION_MAX         (float)0.60     // max step correction allowed in a single segment
 #define STEP_CORRECTION_HOLDOFF            5        // minimum number of segments to wait between error correction
 
+/* External encoder correction settings
+ *
+ *  Used instead of the above for motors with an external encoder (see encoder.h). The error is
+ *  measured rather than counted, so it's only corrected once it's outside of the encoder's noise,
+ *  but then a missed step is made up over a few segments instead of a fraction of one. The max is
+ *  a fraction of the segment's own steps so a correction never more than slightly changes velocity.
+ */
+#define EXTERNAL_CORRECTION_THRESHOLD   (float)4.00     // magnitude of filtered error to apply correction (in steps)
+#define EXTERNAL_CORRECTION_FACTOR      (float)0.50     // factor to apply to step correction for a single segment
+#define EXTERNAL_CORRECTION_MAX         (float)0.25     // max step correction as a fraction of the segment's steps
+#define EXTERNAL_CORRECTION_HOLDOFF            3        // minimum number of segments to wait between error correction
+
+/* Driver status and stall inputs
+ *
+ *  Drivers that report status (e.g. Trinamic stallGuard, current and temperature) are read
+ *  one at a time, round-robin, every DRIVER_STATUS_INTERVAL_MS - so each driver is read every
+ *  MOTORS intervals. A driver that detects stalls reports them as a virtual digital input,
+ *  numbered after the board's real inputs, which can be used as a homing input.
+ */
+#define DRIVER_STATUS_INTERVAL_MS   1                               // ms between driver status reads
+#define STALL_INPUT(motor)          (D_IN_CHANNELS + 1 + (motor))   // virtual input number of a motor's stalls
+
 /*
  * Stepper control structures
  *
@@ -348,6 +370,7 @@ typedef struct cfgMotor {                   // per-motor configs
     uint8_t  polarity;                      // 0=normal polarity, 1=reverse motor direction
     float power_level;                      // set 0.000 to 1.000 for PWM vref setting
     float power_level_idle;                 // set 0.000 to 1.000 for PWM vref idle setting
+    uint8_t homing_input;                   // input that stops this motor when homing, 0 to use its axis' input
     float step_angle;                       // degrees per whole step (ex: 1.8)
     float travel_rev;                       // mm or deg of travel per motor revolution
     float steps_per_unit;                   // microsteps per mm (or degree) of travel
@@ -373,7 +396,9 @@ typedef struct stRunMotor {                 // one per controlled motor
 typedef struct stRunSingleton {             // Stepper static values and axis parameters
     magic_t magic_start;                    // magic number to test memory integrity
     uint32_t dda_ticks_downcount;           // dda tick down-counter (unscaled)
+    volatile uint32_t dda_ticks_end;        // DDA ticks run (wrapping) at the end of this segment
     uint32_t dwell_ticks_downcount;         // dwell tick down-counter (unscaled)
+    volatile uint8_t locked_motors;         // motors stopped by st_lock_motor(), one bit per motor
     stRunMotor_t mot[MOTORS];               // runtime motor structures
     magic_t magic_end;
 } stRunSingleton_t;
@@ -410,6 +435,8 @@ typedef struct stPrepSingleton {
     uint32_t dda_ticks;                     // DDA ticks for the move
     float dda_ticks_holdover;               // partial DDA ticks from previous segment
     uint32_t dwell_ticks;                   // dwell ticks remaining
+    float spindle_speed;                    // S word of the move the prepped line is from
+    float velocity_factor;                  // line's velocity as a fraction of its move's cruise velocity
     stPrepMotor_t mot[MOTORS];              // prep time motor structs
     magic_t magic_end;
 } stPrepSingleton_t;
@@ -497,6 +524,8 @@ public:
 
     virtual void periodicCheck(bool have_actually_stopped) {}; // can be overridden
     virtual void setActivityTimeout(float idle_milliseconds) {}; // can be overridden
+    virtual void requestStatus() {};                        // read driver status, if it has any
+    virtual void setStallInput(const uint8_t input_number) {}; // report stalls as this input, if detected
 
     /* Functions that must be implemented in subclasses */
 
@@ -525,6 +554,7 @@ class ExternalEncoder {
     virtual void requestAngleFraction();
 
     virtual float getQuadratureFraction();
+    virtual uint32_t getSampleTime();   // SysTick time (ms) of the last reading
 };
 
 /**** FUNCTION PROTOTYPES ****/
@@ -535,6 +565,11 @@ void stepper_init_assertions(void);
 stat_t stepper_test_assertions(void);
 
 bool st_runtime_isbusy(void);
+uint32_t st_get_dda_ticks(void);
+float st_get_substep_phase(const uint8_t motor);
+float st_get_step_rate(const uint8_t motor);
+void st_lock_motor(const uint8_t motor);
+void st_unlock_motors(void);
 stat_t st_clc(nvObj_t *nv);
 void st_set_motor_power(const uint8_t motor);
 stat_t st_motor_power_callback(void);
@@ -546,6 +581,7 @@ void st_prep_null(void);
 void st_prep_command(void *bf);        // use a void pointer since we don't know about mpBuf_t yet)
 void st_prep_dwell(float milliseconds);
 void st_prep_out_of_band_dwell(float milliseconds);
+void st_prep_toolhead(const float speed, const float velocity_factor);
 stat_t st_prep_line(const float start_velocity, const float end_velocity, const float travel_steps[], const float following_error[], const float segment_time)  HOT_FUNC;
 // NOTE: this version is the same, except it's passed an array of start/end velocities, one pair per motor
 stat_t st_prep_line(const float start_velocities[], const float end_velocities[], const float travel_steps[], const float following_error[], const float segment_time)  HOT_FUNC;
@@ -574,6 +610,8 @@ stat_t st_get_pl(nvObj_t *nv);
 stat_t st_get_pi(nvObj_t *nv);
 stat_t st_set_pl(nvObj_t *nv);
 stat_t st_set_pi(nvObj_t *nv);
+stat_t st_get_hi(nvObj_t *nv);
+stat_t st_set_hi(nvObj_t *nv);
 
 stat_t st_get_pwr(nvObj_t *nv);
 
@@ -596,6 +634,7 @@ stat_t st_get_dw(nvObj_t *nv);
     void st_print_pm(nvObj_t *nv);
     void st_print_pl(nvObj_t *nv);
     void st_print_pi(nvObj_t *nv);
+    void st_print_hi(nvObj_t *nv);
     void st_print_pwr(nvObj_t *nv);
     void st_print_mt(nvObj_t *nv);
     void st_print_me(nvObj_t *nv);
@@ -614,6 +653,7 @@ stat_t st_get_dw(nvObj_t *nv);
     #define st_print_pm tx_print_stub
     #define st_print_pl tx_print_stub
     #define st_print_pi tx_print_stub
+    #define st_print_hi tx_print_stub
     #define st_print_pwr tx_print_stub
     #define st_print_mt tx_print_stub
     #define st_print_me tx_print_stub
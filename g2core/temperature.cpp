@@ -52,6 +52,15 @@
 #ifndef HAS_TEMPERATURE_SENSOR_3
 #define HAS_TEMPERATURE_SENSOR_3  false
 #endif
+#ifndef HAS_TEMPERATURE_SENSOR_4
+#define HAS_TEMPERATURE_SENSOR_4  false
+#endif
+#ifndef HAS_TEMPERATURE_SENSOR_5
+#define HAS_TEMPERATURE_SENSOR_5  false
+#endif
+#ifndef HAS_TEMPERATURE_SENSOR_6
+#define HAS_TEMPERATURE_SENSOR_6  false
+#endif
 #ifndef EXTRUDER_1_OUTPUT_PIN
 #define EXTRUDER_1_OUTPUT_PIN Motate::kOutput1_PinNumber
 #endif
@@ -69,6 +78,17 @@
 // OR
 //#define BED_OUTPUT_INIT {kPWMPinInverted, fet_pin3_freq};
 #endif
+// Heaters 4 to 6 (multi-zone beds, chamber heaters) have no output unless the settings give
+// them one with HEATER_n_OUTPUT_PIN, and optionally HEATER_n_OUTPUT_INIT
+#ifndef HEATER_4_OUTPUT_INIT
+#define HEATER_4_OUTPUT_INIT {Motate::kNormal, fet_pin4_freq}
+#endif
+#ifndef HEATER_5_OUTPUT_INIT
+#define HEATER_5_OUTPUT_INIT {Motate::kNormal, fet_pin5_freq}
+#endif
+#ifndef HEATER_6_OUTPUT_INIT
+#define HEATER_6_OUTPUT_INIT {Motate::kNormal, fet_pin6_freq}
+#endif
 
 // These could be moved to settings
 // If the temperature stays at set_point +- TEMP_SETPOINT_HYSTERESIS for more
@@ -121,6 +141,54 @@
 #define TEMP_MIN_RISE_DEGREES_FROM_TARGET (float)10.0
 #endif
 
+// The PIDs are run every TEMP_PID_INTERVAL ms, unless the settings give a heater its own
+// interval. Slow heaters like beds and chambers don't need updating as often as a hot end.
+#define TEMP_PID_INTERVAL 100
+#ifndef H1_PID_INTERVAL
+#define H1_PID_INTERVAL TEMP_PID_INTERVAL
+#endif
+#ifndef H2_PID_INTERVAL
+#define H2_PID_INTERVAL TEMP_PID_INTERVAL
+#endif
+#ifndef H3_PID_INTERVAL
+#define H3_PID_INTERVAL TEMP_PID_INTERVAL
+#endif
+#ifndef H4_PID_INTERVAL
+#define H4_PID_INTERVAL TEMP_PID_INTERVAL
+#endif
+#ifndef H5_PID_INTERVAL
+#define H5_PID_INTERVAL TEMP_PID_INTERVAL
+#endif
+#ifndef H6_PID_INTERVAL
+#define H6_PID_INTERVAL TEMP_PID_INTERVAL
+#endif
+
+#if (HEATERS < 3) || (HEATERS > 6)
+#error HEATERS must be 3 to 6
+#endif
+
+// Autotune - see PID::_autotune(). The heater is switched full on and off around the target
+// for TEMP_AUTOTUNE_CYCLES cycles (unless told otherwise). It holds each state for at least
+// TEMP_AUTOTUNE_HOLD_TIME ms so sensor noise doesn't switch it, and fails if the temperature
+// goes TEMP_AUTOTUNE_OVERSHOOT degrees over the target, or a state lasts TEMP_AUTOTUNE_TIMEOUT ms.
+#ifndef TEMP_AUTOTUNE_CYCLES
+#define TEMP_AUTOTUNE_CYCLES 5
+#endif
+#ifndef TEMP_AUTOTUNE_HOLD_TIME
+#define TEMP_AUTOTUNE_HOLD_TIME 5000
+#endif
+#ifndef TEMP_AUTOTUNE_OVERSHOOT
+#define TEMP_AUTOTUNE_OVERSHOOT (float)20.0
+#endif
+#ifndef TEMP_AUTOTUNE_TIMEOUT
+#define TEMP_AUTOTUNE_TIMEOUT (float)(20.0 * 60.0 * 1000.0) // twenty minutes
+#endif
+
+// The output the feed-forward model reads for the part cooling fan (Marlin M106 sets out4)
+#ifndef TEMP_PART_FAN_OUTPUT
+#define TEMP_PART_FAN_OUTPUT out4
+#endif
+
 
 /**** Allocate structures ****/
 
@@ -139,6 +207,10 @@ struct TemperatureSensor {
         return -1; // invalid temperature
     };
 
+    float temperature() {
+        return -1; // invalid temperature
+    };
+
     float get_resistance() {
         return -1; // invalid temperature from a thermistor
     };
@@ -291,6 +363,13 @@ struct Thermistor {
     const float variance_max = 1.1;
     ValueHistory<20> history {variance_max};
 
+    // Voltage at min_temp, min_temp + kTableStep, ... max_temp, falling as the temperature rises.
+    // Uniform in temperature so the interpolation error is even - about 0.1C at 64 segments.
+    static constexpr uint8_t kTableSegments = 64;
+    static constexpr float kTableStep = (float)(max_temp - min_temp) / kTableSegments;
+    float table_voltage[kTableSegments+1];
+    bool table_valid = false;
+
     typedef Thermistor<ADC_t, min_temp, max_temp> type;
 
     // References for thermistor formulas:
@@ -344,6 +423,61 @@ struct Thermistor {
         c3 = (x-z*w/y)/(v-z*u/y);
         c2 = (x-c3*v)/z;
         c1 = 1/temp_low_fixed-c3*pow(a1,3)-c2*a1;
+
+        build_table();
+    };
+
+    // Fill the voltage table used by temperature() - this is Steinhart-Hart solved for the
+    // resistance at each table temperature, then turned into the voltage the circuit reads.
+    // Done in double since it's only done once and the terms nearly cancel.
+    void build_table() {
+        table_valid = true;
+        for (uint8_t i = 0; i <= kTableSegments; i++) {
+            double t_inv = 1/(min_temp + i*kTableStep + 273.15);
+            double x = (c1 - t_inv)/c3;
+            double y = sqrt(pow(c2/(3.0*c3), 3) + x*x/4);
+            double r = exp(cbrt(y - x/2) - cbrt(y + x/2));
+            table_voltage[i] = circuit->get_voltage(r);
+
+            // The table only works where the voltage falls as the temperature rises, and where
+            // the exact path wouldn't call the sensor disconnected. Otherwise always use that.
+            if (!isfinite(table_voltage[i]) ||
+                ((i == 0) && (r > TEMP_MIN_DISCONNECTED_RESISTANCE)) ||
+                ((i > 0) && !(table_voltage[i] < table_voltage[i-1]))) {
+                table_valid = false;
+            }
+        }
+    };
+
+    // Temperature from the table - no transcendental math, just a binary search for the
+    // segment and a linear interpolation across it. Readings outside the table (and any
+    // reading if the table couldn't be made) go to temperature_exact(), which also does the
+    // disconnected sensor checks.
+    float temperature() {
+        if (!table_valid) {
+            return temperature_exact();
+        }
+        if (raw_adc_value < 1) {
+            return -1; // invalid temperature from a thermistor
+        }
+
+        float v = raw_adc_voltage = history.value();
+        if (!(v < table_voltage[0]) || !(v > table_voltage[kTableSegments])) {     // also catches NaN
+            return temperature_exact();
+        }
+
+        uint8_t lo = 0;                     // table_voltage[lo] > v >= table_voltage[hi]
+        uint8_t hi = kTableSegments;
+        while (hi - lo > 1) {
+            uint8_t mid = (lo + hi) / 2;
+            if (table_voltage[mid] > v) {
+                lo = mid;
+            } else {
+                hi = mid;
+            }
+        }
+        float fraction = (table_voltage[lo] - v) / (table_voltage[lo] - table_voltage[hi]);
+        return min_temp + (lo + fraction) * kTableStep;
     };
 
     float temperature_exact() {
@@ -479,6 +613,11 @@ struct PT100 {
         return t;
     };
 
+    // The RTD conversion is one square root, so there's no table to use in its place
+    float temperature() {
+        return temperature_exact();
+    };
+
     float get_resistance() {
         raw_adc_voltage = history.value();
 
@@ -568,9 +707,32 @@ TEMPERATURE_SENSOR_3_TYPE temperature_sensor_3 TEMPERATURE_SENSOR_3_INIT;
 TemperatureSensor temperature_sensor_3;
 #endif
 
-float last_reported_temp1 = 0; // keep track of what we've reported for SR generation
-float last_reported_temp2 = 0;
-float last_reported_temp3 = 0;
+#if (HEATERS >= 4)
+#if HAS_TEMPERATURE_SENSOR_4
+TEMPERATURE_SENSOR_4_CIRCUIT_TYPE temperature_sensor_4_circuit TEMPERATURE_SENSOR_4_CIRCUIT_INIT;
+TEMPERATURE_SENSOR_4_TYPE temperature_sensor_4 TEMPERATURE_SENSOR_4_INIT;
+#else
+TemperatureSensor temperature_sensor_4;
+#endif
+#endif
+
+#if (HEATERS >= 5)
+#if HAS_TEMPERATURE_SENSOR_5
+TEMPERATURE_SENSOR_5_CIRCUIT_TYPE temperature_sensor_5_circuit TEMPERATURE_SENSOR_5_CIRCUIT_INIT;
+TEMPERATURE_SENSOR_5_TYPE temperature_sensor_5 TEMPERATURE_SENSOR_5_INIT;
+#else
+TemperatureSensor temperature_sensor_5;
+#endif
+#endif
+
+#if (HEATERS >= 6)
+#if HAS_TEMPERATURE_SENSOR_6
+TEMPERATURE_SENSOR_6_CIRCUIT_TYPE temperature_sensor_6_circuit TEMPERATURE_SENSOR_6_CIRCUIT_INIT;
+TEMPERATURE_SENSOR_6_TYPE temperature_sensor_6 TEMPERATURE_SENSOR_6_INIT;
+#else
+TemperatureSensor temperature_sensor_6;
+#endif
+#endif
 
 
 // Output 1 FET info
@@ -599,6 +761,34 @@ PWMOutputPin<BED_OUTPUT_PIN> fet_pin3 BED_OUTPUT_INIT;
 PWMOutputPin<-1> fet_pin3;// {kPWMPinInverted};
 #endif
 
+// Heaters 4 to 6
+#if (HEATERS >= 4)
+const int32_t fet_pin4_freq = 100;
+#if (TEMPERATURE_OUTPUT_ON == 1) && defined(HEATER_4_OUTPUT_PIN)
+PWMOutputPin<HEATER_4_OUTPUT_PIN> fet_pin4 HEATER_4_OUTPUT_INIT;
+#else
+PWMOutputPin<-1> fet_pin4;
+#endif
+#endif
+
+#if (HEATERS >= 5)
+const int32_t fet_pin5_freq = 100;
+#if (TEMPERATURE_OUTPUT_ON == 1) && defined(HEATER_5_OUTPUT_PIN)
+PWMOutputPin<HEATER_5_OUTPUT_PIN> fet_pin5 HEATER_5_OUTPUT_INIT;
+#else
+PWMOutputPin<-1> fet_pin5;
+#endif
+#endif
+
+#if (HEATERS >= 6)
+const int32_t fet_pin6_freq = 100;
+#if (TEMPERATURE_OUTPUT_ON == 1) && defined(HEATER_6_OUTPUT_PIN)
+PWMOutputPin<HEATER_6_OUTPUT_PIN> fet_pin6 HEATER_6_OUTPUT_INIT;
+#else
+PWMOutputPin<-1> fet_pin6;
+#endif
+#endif
+
 
 // DO_3: Fan1A_PWM
 //PWMOutputPin<Motate::kOutput3_PinNumber> fan_pin1;
@@ -623,23 +813,6 @@ PWMOutputPin<-1> fet_pin3;// {kPWMPinInverted};
 //}
 //#endif
 
-#if TEMPERATURE_OUTPUT_ON == 1
-
-// We're going to register a SysTick event
-const int16_t temperature_sample_freq = 10; // every fet_pin1_sample_freq interrupts, sample
-int16_t temperature_sample_counter = temperature_sample_freq;
-Motate::SysTickEvent adc_tick_event {[&] {
-    if (!--temperature_sample_counter) {
-        temperature_sensor_1.start_sampling();
-        temperature_sensor_2.start_sampling();
-        temperature_sensor_3.start_sampling();
-        temperature_sample_counter = temperature_sample_freq;
-    }
-}, nullptr};
-
-#endif
-
-
 struct PID {
     static constexpr float output_max = 1.0;
     static constexpr float derivative_contribution = 1.0/10.0;
@@ -648,6 +821,8 @@ struct PID {
     float _i_factor;                // the scale for I values
     float _d_factor;                // the scale for D values
     float _f_factor;                // the scale for O values
+    float _fan_factor = 0.0;        // output added with the part cooling fan full on
+    float _extrusion_factor = 0.0;  // output added per mm/s of filament being extruded
 
     float _proportional = 0.0;      // _proportional storage
     float _integral = 0.0;          // _integral storage
@@ -667,10 +842,28 @@ struct PID {
     float _average_output = 0;
 
     bool _enable;                   // set true to enable this heater
-
-    PID(float P, float I, float D, float F, float min_rise_over_time, float startSetPoint = 0.0) : _p_factor{P/100.0f}, _i_factor{I/100.0f}, _d_factor{D/100.0f}, _f_factor{F/100.0f}, _set_point{startSetPoint}, _at_set_point{false}, _min_rise_over_time(min_rise_over_time) {};
-
-    float getNewOutput(float input) {
+    const uint16_t _interval;       // ms between updates - the I and D factors are per update
+
+    struct {                        // autotune state - see _autotune()
+        uint8_t cycles = 0;         // cycles to run, 0 if not running
+        uint8_t cycle;              // cycles started
+        cmAutotuneState state = AUTOTUNE_OFF;
+        bool reported = true;       // the result has been reported
+        bool heating;               // relay is on
+        float target;
+        float bias;                 // relay output is bias +- amplitude
+        float amplitude;
+        float max;                  // highest temperature since the relay last went off
+        float min;                  // lowest temperature since the relay last went on
+        uint32_t switched_at;       // SysTick time of the last relay switch
+        uint32_t high_time;         // time the relay was on last cycle (ms)
+        bool tuned = false;         // p, i and d are from a measured cycle
+        float p = 0, i = 0, d = 0;  // tuned factors, in the units of _p_factor etc.
+    } _tune;
+
+    PID(float P, float I, float D, float F, float min_rise_over_time, uint16_t interval, float startSetPoint = 0.0) : _p_factor{P/100.0f}, _i_factor{I/100.0f}, _d_factor{D/100.0f}, _f_factor{F/100.0f}, _set_point{startSetPoint}, _at_set_point{false}, _min_rise_over_time(min_rise_over_time), _interval{interval} {};
+
+    float getNewOutput(float input, const float fan = 0.0, const float extrusion_rate = 0.0) {
         // If the input is < 0, the sensor failed
         if (input < 0) {
             if (_set_point > TEMP_OFF_BELOW) {
@@ -717,6 +910,13 @@ struct PID {
             }
         }
 
+        // Autotune replaces the PID output until it's done
+        if (_tune.cycles) {
+            _previous_input = input;
+            _average_output = (input > TEMP_MAX_SETPOINT) ? 0 : _autotune(input);
+            return _average_output;
+        }
+
         // P = Proportional
 
         float p = _p_factor * e;
@@ -752,9 +952,12 @@ struct PID {
 
         // F = feed-forward
 
+        // The heat lost to the room at the set point, plus what the part cooling fan and the
+        // filament being melted take away. The last two are applied as soon as they change,
+        // rather than waiting for the temperature to drop and the integral to catch up.
         _feed_forward = (_set_point-21); // 21 is for a roughly ideal room temperature
-
         float f = _f_factor * _feed_forward;
+        f += (_fan_factor * fan) + (_extrusion_factor * extrusion_rate);
 
         _previous_input = input;
 
@@ -794,15 +997,131 @@ struct PID {
     bool atSetPoint() {
         return _at_set_point;
     }
+
+    /*
+     * startAutotune()  - start a relay autotune cycle at the target temperature
+     * cancelAutotune() - stop autotune without changing the PID factors
+     * _autotune()      - return the relay output for this input, and tune when a cycle completes
+     * _endAutotune()   - leave autotune, with the heater off
+     *
+     *  This is the relay (Astrom-Hagglund) method also used by Marlin's M303. The heater is
+     *  switched on when the temperature falls below the target and off when it rises above it,
+     *  which makes it oscillate at its ultimate period Tu. With a relay amplitude d and a
+     *  temperature amplitude a the ultimate gain is Ku = 4d / (pi * a). The relay bias is moved
+     *  each cycle to even out the on and off times, so the oscillation is centered on the target.
+     *
+     *  The factors are from the Ziegler-Nichols "some overshoot" rule - Kp = Ku/3, Ti = Tu/2,
+     *  Td = Tu/3 - which overshoots much less than the classic rule. They are converted to the
+     *  units used here: the integral and derivative are per update (_interval), not per second.
+     */
+
+    void startAutotune(const float target, const uint8_t cycles) {
+        _tune.cycles = cycles;
+        _tune.cycle = 0;
+        _tune.state = AUTOTUNE_RUNNING;
+        _tune.reported = true;
+        _tune.heating = true;
+        _tune.target = target;
+        _tune.bias = 0.5;
+        _tune.amplitude = 0.5;
+        _tune.max = 0;
+        _tune.min = target;
+        _tune.switched_at = Motate::SysTickTimer.getValue();
+        _tune.tuned = false;
+        _tune.p = 0;
+        _tune.i = 0;
+        _tune.d = 0;
+        _set_point = target;            // so the rise time and at-temperature checks still run
+        _integral = 0;
+    }
+
+    void cancelAutotune() {
+        if (_tune.cycles) {
+            _tune.cycles = 0;
+            _tune.state = AUTOTUNE_OFF;
+        }
+    }
+
+    void _endAutotune(const cmAutotuneState state) {
+        _tune.cycles = 0;
+        _tune.state = state;
+        _tune.reported = false;
+        _set_point = 0;
+        _integral = 0;
+    }
+
+    float _autotune(const float input) {
+        const uint32_t now = Motate::SysTickTimer.getValue();
+        const uint32_t held = now - _tune.switched_at;
+
+        if ((input > _tune.target + TEMP_AUTOTUNE_OVERSHOOT) || (held > TEMP_AUTOTUNE_TIMEOUT)) {
+            _endAutotune(AUTOTUNE_FAILED);
+            return 0;
+        }
+        _tune.max = std::max(_tune.max, input);
+        _tune.min = std::min(_tune.min, input);
+
+        if (_tune.heating) {
+            if ((input > _tune.target) && (held > TEMP_AUTOTUNE_HOLD_TIME)) {
+                _tune.heating = false;
+                _tune.high_time = held;
+                _tune.switched_at = now;
+                _tune.max = input;
+            }
+        } else if ((input < _tune.target) && (held > TEMP_AUTOTUNE_HOLD_TIME)) {
+            _tune.heating = true;
+            _tune.switched_at = now;
+
+            if (_tune.cycle > 0) {      // a full cycle - skip the first, which started from cold
+                const uint32_t low_time = held;
+                _tune.bias += (_tune.amplitude * ((float)_tune.high_time - (float)low_time)) / (float)(_tune.high_time + low_time);
+                _tune.bias = std::min(std::max(_tune.bias, 0.1f), 0.9f);
+
+                const float a = (_tune.max - _tune.min) / 2;
+                if ((_tune.cycle > 1) && (a > EPSILON)) {   // the second cycle has a settled bias
+                    const float ku = (4 * _tune.amplitude) / (M_PI * a);
+                    const float tu = (_tune.high_time + low_time) / 1000.0;
+                    const float interval = _interval / 1000.0;
+                    _tune.p = ku / 3;
+                    _tune.i = (_tune.p / (tu / 2)) * interval;
+                    _tune.d = (_tune.p * (tu / 3)) / interval;
+                    _tune.tuned = true;
+                }
+                _tune.amplitude = std::min(_tune.bias, 1 - _tune.bias);
+            }
+            _tune.min = input;
+
+            if (++_tune.cycle > _tune.cycles) {
+                if (!_tune.tuned) {     // no cycle had a usable amplitude - leave the factors alone
+                    _endAutotune(AUTOTUNE_FAILED);
+                    return 0;
+                }
+                _p_factor = _tune.p;
+                _i_factor = _tune.i;
+                _d_factor = _tune.d;
+                _endAutotune(AUTOTUNE_DONE);
+                return 0;
+            }
+        }
+        return (_tune.heating ? (_tune.bias + _tune.amplitude) : (_tune.bias - _tune.amplitude));
+    }
 };
 
 // NOTICE, the JSON alters incoming values for these!
 // {he1p:9} == 9.0/100.0 here
 
-PID pid1 { 9.0, 0.11, 400.0, 0, TEMP_MIN_RISE_DEGREES_OVER_TIME }; // default values
-PID pid2 { 7.5, 0.12, 400.0, 0, TEMP_MIN_RISE_DEGREES_OVER_TIME }; // default values
-PID pid3 { 7.5, 0.12, 400.0, 0, TEMP_MIN_BED_RISE_DEGREES_OVER_TIME }; // default values
-Timeout pid_timeout;
+PID pid1 { 9.0, 0.11, 400.0, 0, TEMP_MIN_RISE_DEGREES_OVER_TIME, H1_PID_INTERVAL }; // default values
+PID pid2 { 7.5, 0.12, 400.0, 0, TEMP_MIN_RISE_DEGREES_OVER_TIME, H2_PID_INTERVAL }; // default values
+PID pid3 { 7.5, 0.12, 400.0, 0, TEMP_MIN_BED_RISE_DEGREES_OVER_TIME, H3_PID_INTERVAL }; // default values
+#if (HEATERS >= 4)
+PID pid4 { 7.5, 0.12, 400.0, 0, TEMP_MIN_BED_RISE_DEGREES_OVER_TIME, H4_PID_INTERVAL }; // default values
+#endif
+#if (HEATERS >= 5)
+PID pid5 { 7.5, 0.12, 400.0, 0, TEMP_MIN_BED_RISE_DEGREES_OVER_TIME, H5_PID_INTERVAL }; // default values
+#endif
+#if (HEATERS >= 6)
+PID pid6 { 7.5, 0.12, 400.0, 0, TEMP_MIN_BED_RISE_DEGREES_OVER_TIME, H6_PID_INTERVAL }; // default values
+#endif
 
 
 template<pin_number heater_fan_pinnum>
@@ -837,6 +1156,123 @@ struct HeaterFan {
 
 HeaterFan<EXTRUDER_1_FAN_PIN> heater_fan1;
 
+
+/**** Heater channels ****/
+
+// Each heater is a channel: a sensor, a PID, and the output the PID drives. The sensors and
+// outputs are different types on each machine, so the channel uses them through these.
+struct HeaterSensor {
+    virtual float temperature() = 0;
+    virtual float get_resistance() = 0;
+    virtual float get_raw_value() = 0;
+    virtual float get_voltage() = 0;
+    virtual void start_sampling() = 0;
+};
+
+template <typename sensor_t>
+struct HeaterSensorOf final : HeaterSensor {
+    sensor_t &sensor;
+    HeaterSensorOf(sensor_t &_sensor) : sensor{_sensor} {};
+
+    float temperature() override { return sensor.temperature(); };
+    float get_resistance() override { return sensor.get_resistance(); };
+    float get_raw_value() override { return (float)sensor.get_raw_value(); };
+    float get_voltage() override { return sensor.get_voltage(); };
+    void start_sampling() override { sensor.start_sampling(); };
+};
+
+struct HeaterOutput {
+    virtual void write(const float value) = 0;
+    virtual float read() = 0;
+};
+
+template <typename pin_t>
+struct HeaterOutputOf final : HeaterOutput {
+    pin_t &pin;
+    HeaterOutputOf(pin_t &_pin) : pin{_pin} {};
+
+    void write(const float value) override { pin.write(value); };
+    float read() override { return (float)pin; };
+};
+
+struct HeaterChannel {
+    PID &pid;
+    HeaterSensor &sensor;
+    HeaterOutput &output;
+    const int8_t extruder_axis;     // axis extruding this heater's filament, or -1 if none
+
+    float temperature = 0;          // as of the last update
+    float last_reported_temp = 0;   // keep track of what we've reported for SR generation
+    uint32_t next_update = 0;       // SysTick time the next update is due
+
+    HeaterChannel(PID &_pid, HeaterSensor &_sensor, HeaterOutput &_output, const int8_t _extruder_axis)
+        : pid{_pid}, sensor{_sensor}, output{_output}, extruder_axis{_extruder_axis} {};
+};
+
+HeaterSensorOf<decltype(temperature_sensor_1)> heater_sensor1 {temperature_sensor_1};
+HeaterSensorOf<decltype(temperature_sensor_2)> heater_sensor2 {temperature_sensor_2};
+HeaterSensorOf<decltype(temperature_sensor_3)> heater_sensor3 {temperature_sensor_3};
+HeaterOutputOf<decltype(fet_pin1)> heater_output1 {fet_pin1};
+HeaterOutputOf<decltype(fet_pin2)> heater_output2 {fet_pin2};
+HeaterOutputOf<decltype(fet_pin3)> heater_output3 {fet_pin3};
+#if (HEATERS >= 4)
+HeaterSensorOf<decltype(temperature_sensor_4)> heater_sensor4 {temperature_sensor_4};
+HeaterOutputOf<decltype(fet_pin4)> heater_output4 {fet_pin4};
+#endif
+#if (HEATERS >= 5)
+HeaterSensorOf<decltype(temperature_sensor_5)> heater_sensor5 {temperature_sensor_5};
+HeaterOutputOf<decltype(fet_pin5)> heater_output5 {fet_pin5};
+#endif
+#if (HEATERS >= 6)
+HeaterSensorOf<decltype(temperature_sensor_6)> heater_sensor6 {temperature_sensor_6};
+HeaterOutputOf<decltype(fet_pin6)> heater_output6 {fet_pin6};
+#endif
+
+// Heaters 1 and 2 are the extruders (A and B), heater 3 is the bed
+HeaterChannel heaters[HEATERS] = {
+    {pid1, heater_sensor1, heater_output1, AXIS_A},
+    {pid2, heater_sensor2, heater_output2, AXIS_B},
+    {pid3, heater_sensor3, heater_output3, -1},
+#if (HEATERS >= 4)
+    {pid4, heater_sensor4, heater_output4, -1},
+#endif
+#if (HEATERS >= 5)
+    {pid5, heater_sensor5, heater_output5, -1},
+#endif
+#if (HEATERS >= 6)
+    {pid6, heater_sensor6, heater_output6, -1},
+#endif
+};
+
+// Return the channel for a heater number (1 to HEATERS), or nullptr
+static HeaterChannel *_heater(const uint8_t heater)
+{
+    if ((heater < 1) || (heater > HEATERS)) {
+        return nullptr;
+    }
+    return &heaters[heater-1];
+}
+
+#if TEMPERATURE_OUTPUT_ON == 1
+
+// We're going to register a SysTick event to start the sensors sampling. Each sensor is
+// sampled every temperature_sample_freq ticks, and they're started on different ticks so
+// the conversions (and their interrupts) are spread out instead of all landing at once.
+const int16_t temperature_sample_freq = 10; // every temperature_sample_freq interrupts, sample
+int16_t temperature_sample_tick = 0;
+Motate::SysTickEvent adc_tick_event {[&] {
+    for (uint8_t h = 0; h < HEATERS; h++) {
+        if (temperature_sample_tick == (h * temperature_sample_freq) / HEATERS) {
+            heaters[h].sensor.start_sampling();
+        }
+    }
+    if (++temperature_sample_tick == temperature_sample_freq) {
+        temperature_sample_tick = 0;
+    }
+}, nullptr};
+
+#endif
+
 /**** Static functions ****/
 
 
@@ -867,86 +1303,115 @@ void temperature_init()
 
 void temperature_reset()
 {
-    // make setpoint 0
-    fet_pin1 = 0.0f;
-    pid1._set_point = 0.0;
-
-    fet_pin2 = 0.0f;
-    pid2._set_point = 0.0;
-
-    fet_pin3 = 0.0f;
-    pid3._set_point = 0.0;
-
-    pid_timeout.set(100);
+    // make setpoint 0, and stagger the first updates over an interval so they stay spread out
+    const uint32_t now = Motate::SysTickTimer.getValue();
+    for (uint8_t h = 0; h < HEATERS; h++) {
+        HeaterChannel &heater = heaters[h];
+        heater.output.write(0.0);
+        heater.pid._set_point = 0.0;
+        heater.pid.cancelAutotune();
+        heater.next_update = now + (heater.pid._interval * (h+1)) / HEATERS;
+    }
 }
 
-// Minimum difference in temp before it'll trigger an SR
-const float kTempDiffSRTrigger = 0.25;
+/*
+ * _report_autotune() - report the result of an autotune once it's done
+ */
 
-stat_t temperature_callback()
+static void _report_autotune(const uint8_t heater, PID &pid)
 {
-    if (cm->machine_state == MACHINE_ALARM) {
-        // Force the heaters off (redundant with the safety circuit)
-        fet_pin1 = 0.0;
-        fet_pin2 = 0.0;
-        fet_pin3 = 0.0;
+    if (pid._tune.reported) {
+        return;
+    }
+    pid._tune.reported = true;
+
+    char msg[NV_MESSAGE_LEN];
+    if (pid._tune.state == AUTOTUNE_DONE) {     // reported in the units used by he1p, he1i and he1d
+        sprintf(msg, "Heater %d autotune done: p:%.3f i:%.5f d:%.3f", heater,
+                (double)(pid._p_factor * 100.0), (double)(pid._i_factor * 100.0), (double)(pid._d_factor * 100.0));
+    } else {
+        sprintf(msg, "Heater %d autotune failed", heater);
+    }
+    nv_reset_nv_list();
+    nv_add_conditional_message(msg);
+    nv_print_list(STAT_OK, TEXT_MULTILINE_FORMATTED, JSON_RESPONSE_FORMAT);
+}
 
-        // Force all PIDs to off too
-        pid1._set_point = 0.0;
-        pid2._set_point = 0.0;
-        pid3._set_point = 0.0;
+/*
+ * _update_heater() - read a heater's temperature and run its PID
+ */
 
-        return (STAT_OK);
+static void _update_heater(HeaterChannel &heater)
+{
+    if (heater.pid._enable) {
+        // feed-forward model inputs - extrusion rates are in mm/s of filament
+        const float part_fan = TEMP_PART_FAN_OUTPUT.getValue();
+        const float extrusion_rate = (heater.extruder_axis < 0) ? 0.0 :
+                                     mp_get_runtime_axis_velocity(heater.extruder_axis) / 60;
+
+        heater.temperature = heater.sensor.temperature();
+        heater.output.write(heater.pid.getNewOutput(heater.temperature, part_fan, extrusion_rate));
     }
 
-    if (pid_timeout.isPast()) {
-        pid_timeout.set(100);
-
-        float temp = 0.0;
+    if (heater.extruder_axis >= 0) {   // the heater fan follows the hottest enabled extruder
         float fan_temp = 0.0;
-        bool sr_requested = false;
-
-        if (pid1._enable) {
-            temp = temperature_sensor_1.temperature_exact();
-            float out1_value = pid1.getNewOutput(temp);
-            fet_pin1.write(out1_value);
-
-            if (std::abs(temp - last_reported_temp1) > kTempDiffSRTrigger) {
-                last_reported_temp1 = temp;
-                sr_requested = true;
+        for (uint8_t h = 0; h < HEATERS; h++) {
+            if ((heaters[h].extruder_axis >= 0) && heaters[h].pid._enable) {
+                fan_temp = std::max(fan_temp, heaters[h].temperature);
             }
         }
-        fan_temp = temp;
-
-        if (pid2._enable) {
-            temp = temperature_sensor_2.temperature_exact();
-            float out2_value = pid2.getNewOutput(temp);
-            fet_pin2.write(out2_value);
-
-            if (std::abs(temp - last_reported_temp2) > kTempDiffSRTrigger) {
-                last_reported_temp2 = temp;
-                sr_requested = true;
-            }
-        }
-        fan_temp = std::max(fan_temp, temp);
-
         heater_fan1.newTemp(fan_temp);
+    }
+}
 
-        if (pid3._enable) {
-            temp = temperature_sensor_3.temperature_exact();
-            float out3_value = pid3.getNewOutput(temp);
-            fet_pin3.write(out3_value);
+// Minimum difference in temp before it'll trigger an SR
+const float kTempDiffSRTrigger = 0.25;
 
-            if (std::abs(temp - last_reported_temp3) > kTempDiffSRTrigger) {
-                last_reported_temp3 = temp;
-                sr_requested = true;
-            }
+/*
+ * temperature_callback() - update whichever heater is most overdue
+ *
+ *  Only one heater is updated per pass, so the sensor conversions and PID math for the
+ *  heaters are spread over the main loop instead of all landing on the same pass. Each
+ *  heater keeps to its own interval from when it was last due, not from when it ran.
+ */
+
+stat_t temperature_callback()
+{
+    if (cm->machine_state == MACHINE_ALARM) {
+        // Force the heaters off (redundant with the safety circuit), and all PIDs to off too
+        for (uint8_t h = 0; h < HEATERS; h++) {
+            heaters[h].output.write(0.0);
+            heaters[h].pid._set_point = 0.0;
+            heaters[h].pid.cancelAutotune();
         }
+        return (STAT_OK);
+    }
 
-        if (sr_requested) {
-            sr_request_status_report(SR_REQUEST_TIMED);
+    const uint32_t now = Motate::SysTickTimer.getValue();
+    HeaterChannel *due = nullptr;
+    int32_t due_late = -1;
+    for (uint8_t h = 0; h < HEATERS; h++) {
+        int32_t late = (int32_t)(now - heaters[h].next_update);
+        if (late > due_late) {
+            due = &heaters[h];
+            due_late = late;
         }
     }
+    if (due_late < 0) {
+        return (STAT_OK);
+    }
+
+    due->next_update += due->pid._interval;
+    if (due_late >= due->pid._interval) {   // fell a whole interval behind - don't try to catch up
+        due->next_update = now + due->pid._interval;
+    }
+    _update_heater(*due);
+
+    if (due->pid._enable && (std::abs(due->temperature - due->last_reported_temp) > kTempDiffSRTrigger)) {
+        due->last_reported_temp = due->temperature;
+        sr_request_status_report(SR_REQUEST_TIMED);
+    }
+    _report_autotune((due - heaters) + 1, due->pid);
     return (STAT_OK);
 }
 
@@ -959,27 +1424,28 @@ stat_t temperature_callback()
  * CONFIGURATION AND INTERFACE FUNCTIONS
  * Functions to get and set variables from the cfgArray table
  ***********************************************************************************/
-/*  In these function there are usually 3 PIDs, so a simple switch works.
- *  The default is a failsafe - can only get there if it's set up in config_app, but not here.
+/*  These find the heater channel from the group or token. A missing channel is a failsafe -
+ *  we can only get there if a heater is set up in config_app, but not here.
  */
 
 // helpers
 
-char _get_heater_number(nvObj_t *nv) {  // In these functions nv->group == "he1", "he2", or "he3"
+char _get_heater_number(nvObj_t *nv) {  // In these functions nv->group == "he1", "he2", ... "he6"
     if (!nv->group[0]) {
         return nv->token[2];
     }
     return nv->group[2];
 }
 
+static HeaterChannel *_get_heater(nvObj_t *nv) { return (_heater(_get_heater_number(nv) - '0')); }
+
 stat_t cm_get_heater_enable(nvObj_t *nv)
 {
-    switch(_get_heater_number(nv)) {
-        case '1': { nv->value_int = pid1._enable; break; }
-        case '2': { nv->value_int = pid2._enable; break; }
-        case '3': { nv->value_int = pid3._enable; break; }
-        default: { return(STAT_INPUT_VALUE_RANGE_ERROR); break; }
+    HeaterChannel *heater = _get_heater(nv);
+    if (!heater) {
+        return(STAT_INPUT_VALUE_RANGE_ERROR);
     }
+    nv->value_int = heater->pid._enable;
     nv->valuetype = TYPE_BOOLEAN;
     return (STAT_OK);
 }
@@ -996,12 +1462,11 @@ stat_t cm_set_heater_enable(nvObj_t *nv)
     // The above manipulation of 'enable' was necessary because the compiler won't accept this cast:
     // pid1._enable = (bool)nv->value;   // says it's unsafe to compare ==, != an FP number
 
-    switch(_get_heater_number(nv)) {
-        case '1': { pid1._enable = enable; break; }
-        case '2': { pid2._enable = enable; break; }
-        case '3': { pid3._enable = enable; break; }
-        default: { return(STAT_INPUT_VALUE_RANGE_ERROR); break; } // Failsafe. We can only get here if we set it up in config_app, but not here.
+    HeaterChannel *heater = _get_heater(nv);
+    if (!heater) {
+        return(STAT_INPUT_VALUE_RANGE_ERROR);   // Failsafe. We can only get here if we set it up in config_app, but not here.
     }
+    heater->pid._enable = enable;
     return (STAT_OK);
 }
 
@@ -1016,35 +1481,25 @@ stat_t cm_set_heater_enable(nvObj_t *nv)
 
 stat_t cm_get_heater_p(nvObj_t *nv)
 {
-    switch(_get_heater_number(nv)) {  // there are three of them, so we can use a simple switch
-        case '1': { nv->value_flt = pid1._p_factor * 100.0; break; }
-        case '2': { nv->value_flt = pid2._p_factor * 100.0; break; }
-        case '3': { nv->value_flt = pid3._p_factor * 100.0; break; }
-        default: { nv->value_flt = 0.0; break; }
-    }
+    HeaterChannel *heater = _get_heater(nv);
+    nv->value_flt = heater ? heater->pid._p_factor * 100.0 : 0.0;
     nv->precision = GET_TABLE_WORD(precision);
     nv->valuetype = TYPE_FLOAT;
     return (STAT_OK);
 }
 stat_t cm_set_heater_p(nvObj_t *nv)
 {
-    switch(_get_heater_number(nv)) {
-        case '1': { pid1._p_factor = nv->value_flt / 100.0; break; }
-        case '2': { pid2._p_factor = nv->value_flt / 100.0; break; }
-        case '3': { pid3._p_factor = nv->value_flt / 100.0; break; }
-        default: { break; }
+    HeaterChannel *heater = _get_heater(nv);
+    if (heater) {
+        heater->pid._p_factor = nv->value_flt / 100.0;
     }
     return (STAT_OK);
 }
 
 stat_t cm_get_heater_i(nvObj_t *nv)
 {
-    switch(_get_heater_number(nv)) {
-        case '1': { nv->value_flt = pid1._i_factor * 100.0; break; }
-        case '2': { nv->value_flt = pid2._i_factor * 100.0; break; }
-        case '3': { nv->value_flt = pid3._i_factor * 100.0; break; }
-        default: { nv->value_flt = 0.0; break; }
-    }
+    HeaterChannel *heater = _get_heater(nv);
+    nv->value_flt = heater ? heater->pid._i_factor * 100.0 : 0.0;
     nv->precision = GET_TABLE_WORD(precision);
     nv->valuetype = TYPE_FLOAT;
     return (STAT_OK);
@@ -1052,34 +1507,26 @@ stat_t cm_get_heater_i(nvObj_t *nv)
 
 stat_t cm_set_heater_i(nvObj_t *nv)
 {
-    switch(_get_heater_number(nv)) {
-        case '1': { pid1._i_factor = nv->value_flt / 100.0; break; }
-        case '2': { pid2._i_factor = nv->value_flt / 100.0; break; }
-        case '3': { pid3._i_factor = nv->value_flt / 100.0; break; }
-        default: { break; }
+    HeaterChannel *heater = _get_heater(nv);
+    if (heater) {
+        heater->pid._i_factor = nv->value_flt / 100.0;
     }
     return (STAT_OK);
 }
 
 stat_t cm_get_heater_d(nvObj_t *nv)
 {
-    switch(_get_heater_number(nv)) {
-        case '1': { nv->value_flt = pid1._d_factor * 100.0; break; }
-        case '2': { nv->value_flt = pid2._d_factor * 100.0; break; }
-        case '3': { nv->value_flt = pid3._d_factor * 100.0; break; }
-        default: { nv->value_flt = 0.0; break; }
-    }
+    HeaterChannel *heater = _get_heater(nv);
+    nv->value_flt = heater ? heater->pid._d_factor * 100.0 : 0.0;
     nv->precision = GET_TABLE_WORD(precision);
     nv->valuetype = TYPE_FLOAT;
     return (STAT_OK);
 }
 stat_t cm_set_heater_d(nvObj_t *nv)
 {
-    switch(_get_heater_number(nv)) {
-        case '1': { pid1._d_factor = nv->value_flt / 100.0; break; }
-        case '2': { pid2._d_factor = nv->value_flt / 100.0; break; }
-        case '3': { pid3._d_factor = nv->value_flt / 100.0; break; }
-        default: { break; }
+    HeaterChannel *heater = _get_heater(nv);
+    if (heater) {
+        heater->pid._d_factor = nv->value_flt / 100.0;
     }
     return (STAT_OK);
 }
@@ -1092,30 +1539,109 @@ stat_t cm_set_heater_d(nvObj_t *nv)
  */
 stat_t cm_get_heater_f(nvObj_t *nv)
 {
-    switch(_get_heater_number(nv)) {
-        case '1': { nv->value_flt = pid1._f_factor * 100.0; break; }
-        case '2': { nv->value_flt = pid2._f_factor * 100.0; break; }
-        case '3': { nv->value_flt = pid3._f_factor * 100.0; break; }
-
-        default: { nv->value_flt = 0.0; break; }
+    HeaterChannel *heater = _get_heater(nv);
+    nv->value_flt = heater ? heater->pid._f_factor * 100.0 : 0.0;
+    nv->precision = GET_TABLE_WORD(precision);
+    nv->valuetype = TYPE_FLOAT;
+    return (STAT_OK);
+}
+stat_t cm_set_heater_f(nvObj_t *nv)
+{
+    HeaterChannel *heater = _get_heater(nv);
+    if (heater) {
+        heater->pid._f_factor = nv->value_flt / 100.0;
     }
+    return (STAT_OK);
+}
+
+/****************************************************************************************
+ * cm_get_heater_fan_ff()       - get the part cooling fan feed-forward
+ * cm_set_heater_fan_ff()       - set the part cooling fan feed-forward
+ * cm_get_heater_extrusion_ff() - get the extrusion rate feed-forward
+ * cm_set_heater_extrusion_ff() - set the extrusion rate feed-forward
+ *
+ *  The fan feed-forward is the output added with the fan full on. The extrusion feed-forward
+ *  is the output added per mm/s of filament extruded by the heater's extruder (A for heater 1,
+ *  B for heater 2). Unlike P, I, D and F these are not scaled by 100.
+ */
+
+stat_t cm_get_heater_fan_ff(nvObj_t *nv)
+{
+    HeaterChannel *heater = _get_heater(nv);
+    nv->value_flt = heater ? heater->pid._fan_factor : 0.0;
     nv->precision = GET_TABLE_WORD(precision);
     nv->valuetype = TYPE_FLOAT;
+    return (STAT_OK);
+}
+stat_t cm_set_heater_fan_ff(nvObj_t *nv)
+{
+    HeaterChannel *heater = _get_heater(nv);
+    if (heater) {
+        heater->pid._fan_factor = nv->value_flt;
+    }
+    return (STAT_OK);
+}
 
+stat_t cm_get_heater_extrusion_ff(nvObj_t *nv)
+{
+    HeaterChannel *heater = _get_heater(nv);
+    nv->value_flt = heater ? heater->pid._extrusion_factor : 0.0;
+    nv->precision = GET_TABLE_WORD(precision);
+    nv->valuetype = TYPE_FLOAT;
     return (STAT_OK);
 }
-stat_t cm_set_heater_f(nvObj_t *nv)
+stat_t cm_set_heater_extrusion_ff(nvObj_t *nv)
 {
-    switch(_get_heater_number(nv)) {
-        case '1': { pid1._f_factor = nv->value_flt / 100.0; break; }
-        case '2': { pid2._f_factor = nv->value_flt / 100.0; break; }
-        case '3': { pid3._f_factor = nv->value_flt / 100.0; break; }
+    HeaterChannel *heater = _get_heater(nv);
+    if (heater) {
+        heater->pid._extrusion_factor = nv->value_flt;
+    }
+    return (STAT_OK);
+}
 
-        default: { break; }
+/****************************************************************************************
+ * cm_start_heater_autotune() - start autotuning a heater at the given temperature (0 cycles for the default)
+ * cm_get_heater_autotune()   - get the autotune state - see cmAutotuneState
+ * cm_set_heater_autotune()   - start autotune at the given temperature, or stop it with 0
+ *
+ *  When autotune completes the new factors are used right away and reported, and can then
+ *  be saved by setting he1p, he1i and he1d. The heater is turned off when it ends.
+ */
+
+stat_t cm_start_heater_autotune(const uint8_t heater, const float temperature, uint8_t cycles)
+{
+    if (cycles == 0) {
+        cycles = TEMP_AUTOTUNE_CYCLES;
+    }
+    if ((temperature < TEMP_OFF_BELOW) || (temperature > TEMP_MAX_SETPOINT) || (cycles < 3)) {
+        return (STAT_INPUT_VALUE_RANGE_ERROR);
+    }
+    HeaterChannel *channel = _heater(heater);
+    if (!channel) {
+        return (STAT_INPUT_VALUE_RANGE_ERROR);
     }
+    channel->pid.startAutotune(temperature, cycles);
+    return (STAT_OK);
+}
+
+stat_t cm_get_heater_autotune(nvObj_t *nv)
+{
+    HeaterChannel *heater = _get_heater(nv);
+    nv->value_int = heater ? heater->pid._tune.state : AUTOTUNE_OFF;
+    nv->valuetype = TYPE_INTEGER;
     return (STAT_OK);
 }
 
+stat_t cm_set_heater_autotune(nvObj_t *nv)
+{
+    const uint8_t heater = _get_heater_number(nv) - '0';
+    if (nv->value_flt < EPSILON) {
+        cm_set_set_temperature(heater, 0);
+        return (STAT_OK);
+    }
+    return (cm_start_heater_autotune(heater, nv->value_flt, 0));
+}
+
 /****************************************************************************************
  * cm_get_set_temperature() - get the set value of the PID
  * cm_set_set_temperature() - set the set value of the PID
@@ -1125,13 +1651,8 @@ stat_t cm_set_heater_f(nvObj_t *nv)
 
 float cm_get_set_temperature(const uint8_t heater)
 {
-    switch(heater) {
-        case 1: { return pid1._set_point; break; }
-        case 2: { return pid2._set_point; break; }
-        case 3: { return pid3._set_point; break; }
-        default: { break; }
-    }
-    return 0.0;
+    HeaterChannel *channel = _heater(heater);
+    return (channel ? channel->pid._set_point : 0.0);
 }
 
 stat_t cm_get_set_temperature(nvObj_t *nv)
@@ -1144,13 +1665,10 @@ stat_t cm_get_set_temperature(nvObj_t *nv)
 
 void cm_set_set_temperature(const uint8_t heater, const float value)
 {
-    switch(heater) {
-        case 1: { pid1._set_point = std::min(TEMP_MAX_SETPOINT, value); break; }
-        case 2: { pid2._set_point = std::min(TEMP_MAX_SETPOINT, value); break; }
-        case 3: { pid3._set_point = std::min(TEMP_MAX_SETPOINT, value); break; }
-
-        // default to quiet the compiler
-        default: { break; }
+    HeaterChannel *channel = _heater(heater);
+    if (channel) {                      // setting the temperature ends an autotune
+        channel->pid.cancelAutotune();
+        channel->pid._set_point = std::min(TEMP_MAX_SETPOINT, value);
     }
 }
 stat_t cm_set_set_temperature(nvObj_t *nv)
@@ -1292,13 +1810,8 @@ stat_t cm_set_fan_high_temp(nvObj_t *nv)
 
 bool cm_get_at_temperature(const uint8_t heater)
 {
-    switch(heater) {
-        case 1: { return pid1._at_set_point; }
-        case 2: { return pid2._at_set_point; }
-        case 3: { return pid3._at_set_point; }
-        default: { break; }
-    }
-    return false;
+    HeaterChannel *channel = _heater(heater);
+    return (channel ? channel->pid._at_set_point : false);
 }
 
 stat_t cm_get_at_temperature(nvObj_t *nv)
@@ -1315,13 +1828,8 @@ stat_t cm_get_at_temperature(nvObj_t *nv)
 
 float cm_get_heater_output(const uint8_t heater)
 {
-    switch(heater) {
-        case 1: { return (float)fet_pin1; }
-        case 2: { return (float)fet_pin2; }
-        case 3: { return (float)fet_pin3; }
-        default: { break; }
-    }
-    return 0.0;
+    HeaterChannel *channel = _heater(heater);
+    return (channel ? channel->output.read() : 0.0);
 }
 
 stat_t cm_get_heater_output(nvObj_t *nv)
@@ -1338,13 +1846,8 @@ stat_t cm_get_heater_output(nvObj_t *nv)
 
 stat_t cm_get_heater_adc(nvObj_t *nv)
 {
-    switch(_get_heater_number(nv)) {
-        case '1': { nv->value_flt = (float)temperature_sensor_1.get_raw_value(); break; }
-        case '2': { nv->value_flt = (float)temperature_sensor_2.get_raw_value(); break; }
-        case '3': { nv->value_flt = (float)temperature_sensor_3.get_raw_value(); break; }
-
-        default: { nv->value_flt = 0.0; break; }
-    }
+    HeaterChannel *heater = _get_heater(nv);
+    nv->value_flt = heater ? heater->sensor.get_raw_value() : 0.0;
     nv->precision = GET_TABLE_WORD(precision);
     nv->valuetype = TYPE_FLOAT;
     return (STAT_OK);
@@ -1353,18 +1856,14 @@ stat_t cm_get_heater_adc(nvObj_t *nv)
 /****************************************************************************************
  * cm_get_temperature() - get the current temperature
  */
- float cm_get_temperature(const uint8_t heater)
- {
-     switch(heater) {
-         case 1: { return (last_reported_temp1 = temperature_sensor_1.temperature_exact()); }
-         case 2: { return (last_reported_temp2 = temperature_sensor_2.temperature_exact()); }
-         case 3: { return (last_reported_temp3 = temperature_sensor_3.temperature_exact()); }
-
-         default: { break; }
-     }
-
-     return 0.0;
- }
+float cm_get_temperature(const uint8_t heater)
+{
+    HeaterChannel *channel = _heater(heater);
+    if (!channel) {
+        return 0.0;
+    }
+    return (channel->last_reported_temp = channel->sensor.temperature());
+}
 stat_t cm_get_temperature(nvObj_t *nv)
 {
     nv->value_flt = cm_get_temperature(_get_heater_number(nv) - '0');
@@ -1379,32 +1878,20 @@ stat_t cm_get_temperature(nvObj_t *nv)
 
 stat_t cm_get_thermistor_resistance(nvObj_t *nv)
 {
-    switch(_get_heater_number(nv)) {
-        case '1': { nv->value_flt = temperature_sensor_1.get_resistance(); break; }
-        case '2': { nv->value_flt = temperature_sensor_2.get_resistance(); break; }
-        case '3': { nv->value_flt = temperature_sensor_3.get_resistance(); break; }
-
-        default: { nv->value_flt = 0.0; break; }
-    }
+    HeaterChannel *heater = _get_heater(nv);
+    nv->value_flt = heater ? heater->sensor.get_resistance() : 0.0;
     nv->precision = GET_TABLE_WORD(precision);
     nv->valuetype = TYPE_FLOAT;
-
     return (STAT_OK);
 }
 
 /*
  * cm_get_thermistor_resistance() - get the current temperature
  */
-stat_t cm_get_thermistor_voltage(nvObj_t* nv)
+stat_t cm_get_thermistor_voltage(nvObj_t *nv)
 {
-    switch(_get_heater_number(nv)) {
-        case '1': { nv->value_flt = temperature_sensor_1.get_voltage(); break; }
-        case '2': { nv->value_flt = temperature_sensor_2.get_voltage(); break; }
-        case '3': { nv->value_flt = temperature_sensor_3.get_voltage(); break; }
-
-            // Failsafe. We can only get here if we set it up in config_app, but not here.
-        default: { nv->value_flt = 0.0; break; }
-    }
+    HeaterChannel *heater = _get_heater(nv);
+    nv->value_flt = heater ? heater->sensor.get_voltage() : 0.0;
     nv->precision = GET_TABLE_WORD(precision);
     nv->valuetype = TYPE_FLOAT;
     return (STAT_OK);
@@ -1412,7 +1899,7 @@ stat_t cm_get_thermistor_voltage(nvObj_t* nv)
 
 
 
-// In these functions, nv->group == "pid1", "pid2", or "pid3"
+// In these functions, nv->group == "pid1", "pid2", ... "pid6"
 char _get_pid_number(nvObj_t *nv) {
     if (!nv->group[0]) {
         return nv->token[3];
@@ -1420,6 +1907,12 @@ char _get_pid_number(nvObj_t *nv) {
     return nv->group[3];
 }
 
+static PID *_get_pid(nvObj_t *nv)
+{
+    HeaterChannel *heater = _heater(_get_pid_number(nv) - '0');
+    return (heater ? &heater->pid : nullptr);
+}
+
 
 /****************************************************************************************
  * cm_get_pid_p() - get the active P of the PID (read-only)
@@ -1430,14 +1923,8 @@ char _get_pid_number(nvObj_t *nv) {
 
 stat_t cm_get_pid_p(nvObj_t *nv)
 {
-    switch(_get_pid_number(nv)) {
-        case '1': { nv->value_flt = pid1._proportional; break; }
-        case '2': { nv->value_flt = pid2._proportional; break; }
-        case '3': { nv->value_flt = pid3._proportional; break; }
-
-            // Failsafe. We can only get here if we set it up in config_app, but not here.
-        default: { nv->value_flt = 0.0; break; }
-    }
+    PID *pid = _get_pid(nv);
+    nv->value_flt = pid ? pid->_proportional : 0.0;
     nv->precision = GET_TABLE_WORD(precision);
     nv->valuetype = TYPE_FLOAT;
     return (STAT_OK);
@@ -1445,14 +1932,8 @@ stat_t cm_get_pid_p(nvObj_t *nv)
 
 stat_t cm_get_pid_i(nvObj_t *nv)
 {
-    switch(_get_pid_number(nv)) {
-        case '1': { nv->value_flt = pid1._integral; break; }
-        case '2': { nv->value_flt = pid2._integral; break; }
-        case '3': { nv->value_flt = pid3._integral; break; }
-
-            // Failsafe. We can only get here if we set it up in config_app, but not here.
-        default: { nv->value_flt = 0.0; break; }
-    }
+    PID *pid = _get_pid(nv);
+    nv->value_flt = pid ? pid->_integral : 0.0;
     nv->precision = GET_TABLE_WORD(precision);
     nv->valuetype = TYPE_FLOAT;
     return (STAT_OK);
@@ -1460,14 +1941,8 @@ stat_t cm_get_pid_i(nvObj_t *nv)
 
 stat_t cm_get_pid_d(nvObj_t *nv)
 {
-    switch(_get_pid_number(nv)) {
-        case '1': { nv->value_flt = pid1._derivative; break; }
-        case '2': { nv->value_flt = pid2._derivative; break; }
-        case '3': { nv->value_flt = pid3._derivative; break; }
-
-            // Failsafe. We can only get here if we set it up in config_app, but not here.
-        default: { nv->value_flt = 0.0; break; }
-    }
+    PID *pid = _get_pid(nv);
+    nv->value_flt = pid ? pid->_derivative : 0.0;
     nv->precision = GET_TABLE_WORD(precision);
     nv->valuetype = TYPE_FLOAT;
     return (STAT_OK);
@@ -1475,16 +1950,10 @@ stat_t cm_get_pid_d(nvObj_t *nv)
 
 stat_t cm_get_pid_f(nvObj_t *nv)
 {
-    switch(_get_pid_number(nv)) {
-        case '1': { nv->value_flt = pid1._feed_forward; break; }
-        case '2': { nv->value_flt = pid2._feed_forward; break; }
-        case '3': { nv->value_flt = pid3._feed_forward; break; }
-
-        default: { nv->value_flt = 0.0; break; }
-    }
+    PID *pid = _get_pid(nv);
+    nv->value_flt = pid ? pid->_feed_forward : 0.0;
     nv->precision = GET_TABLE_WORD(precision);
     nv->valuetype = TYPE_FLOAT;
-
     return (STAT_OK);
 }
 
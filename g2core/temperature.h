@@ -29,6 +29,13 @@
 #ifndef TEMPERATURE_H_ONCE
 #define TEMPERATURE_H_ONCE
 
+typedef enum {                      // heater autotune state, as reported by he1au
+    AUTOTUNE_OFF = 0,                   // not run since reset, or stopped
+    AUTOTUNE_RUNNING,
+    AUTOTUNE_DONE,                      // finished, and using the tuned factors
+    AUTOTUNE_FAILED                     // the temperature overshot or a cycle took too long
+} cmAutotuneState;
+
 /*
  * Global Scope Functions
  */
@@ -48,6 +55,13 @@ stat_t cm_get_heater_d(nvObj_t* nv);
 stat_t cm_set_heater_d(nvObj_t* nv);
 stat_t cm_get_heater_f(nvObj_t* nv);
 stat_t cm_set_heater_f(nvObj_t* nv);
+stat_t cm_get_heater_fan_ff(nvObj_t* nv);
+stat_t cm_set_heater_fan_ff(nvObj_t* nv);
+stat_t cm_get_heater_extrusion_ff(nvObj_t* nv);
+stat_t cm_set_heater_extrusion_ff(nvObj_t* nv);
+stat_t cm_start_heater_autotune(const uint8_t heater, const float temperature, uint8_t cycles);
+stat_t cm_get_heater_autotune(nvObj_t* nv);
+stat_t cm_set_heater_autotune(nvObj_t* nv);
 stat_t cm_get_pid_p(nvObj_t* nv);
 stat_t cm_get_pid_i(nvObj_t* nv);
 stat_t cm_get_pid_d(nvObj_t* nv);